@@ -5,10 +5,21 @@
 #include <cctype>
 #include <sstream>
 #include <chrono>
+#include <vector>
+#include <fstream>
 
 #include "models/JobLinkedList.h"
 #include "models/ResumeLinkedList.h"
 #include "io/CsvReader.h"
+#include "io/Snapshot.h"
+#include "utils/BatchRunner.h"
+#include "utils/KeySort.h"
+#include "utils/MatchLogic.h"
+#include "utils/MatchServer.h"
+#include "utils/Query.h"
+#include "utils/TokenDictionary.h"
+#include "utils/WeightedIndex.h"
+#include "utils/DenseEmbedding.h"
 #include "ResumeArray.h"   
 
 #pragma comment(linker, "/STACK:16777216")
@@ -62,77 +73,25 @@ static void print_resume_row(const ResumeLinkedList::Resume& r) {
         << "   Skills=\"" << preview(r.skills, 60) << "\"\n";
 }
 
-
-static void split_tokens_bar_space_heap(const std::string& s,
-    std::string* out, int maxN, int* count) {
-    *count = 0;
-    std::string tok;
-    for (char ch : s) {
-        if (ch == '|' || ch == ',' || std::isspace(static_cast<unsigned char>(ch))) {
-            if (!tok.empty()) {
-                if (*count < maxN) out[(*count)++] = lower_copy(tok);
-                tok.clear();
-            }
-        }
-        else {
-            tok.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
-        }
-    }
-    if (!tok.empty() && *count < maxN) out[(*count)++] = lower_copy(tok);
-}
-
-// simple Jaccard using heap buffers 
-static double jaccard_skills(const std::string& a, const std::string& b) {
-    const int MAXT = 512;                   
-    std::string* A = new std::string[MAXT];
-    std::string* B = new std::string[MAXT];
-    int na = 0, nb = 0;
-    split_tokens_bar_space_heap(a, A, MAXT, &na);
-    split_tokens_bar_space_heap(b, B, MAXT, &nb);
-    if (na == 0 && nb == 0) { delete[] A; delete[] B; return 0.0; }
-
-    // count unique sizes
-    int uniq = 0;
-    for (int i = 0; i < na; ++i) {
-        bool dup = false; for (int k = 0; k < i; ++k) if (A[k] == A[i]) { dup = true; break; }
-        if (!dup) ++uniq;
+// pages of 3 jobs, asking before each next page
+static void show_job_pages(const PagedResults<const JobLinkedList::Job*>& jobs) {
+    for (std::size_t p = 0; p < jobs.pageCount(); ++p) {
+        if (p > 0 && !ask_yes_no()) break;
+        std::cout << "\n--- Results page " << (p + 1) << " -----------------------------\n";
+        std::cout << "ID     Title                                   Required\n";
+        std::cout << "----------------------------------------------------------\n";
+        for (std::size_t k = jobs.pageBegin(p); k < jobs.pageEnd(p); ++k) print_job_row(*jobs[k]);
     }
-    for (int j = 0; j < nb; ++j) {
-        bool dup = false; for (int k = 0; k < j; ++k) if (B[k] == B[j]) { dup = true; break; }
-        if (!dup) ++uniq;
-    }
-
-    int inter = 0;
-    for (int i = 0; i < na; ++i) {
-        bool ai_unique = true; for (int k = 0; k < i; ++k) if (A[k] == A[i]) { ai_unique = false; break; }
-        if (!ai_unique) continue;
-        bool inB = false; for (int j = 0; j < nb; ++j) if (A[i] == B[j]) { inB = true; break; }
-        if (inB) ++inter;
-    }
-    int uni = uniq - inter;
-    delete[] A; delete[] B;
-    if (uni <= 0) return 0.0;
-    return (double)inter / (double)uni;
 }
 
-// pointer array sorters
-static void sort_resume_ptrs_by_name(const ResumeLinkedList::Resume** arr, int n) {
-    for (int i = 1; i < n; ++i) {
-        const ResumeLinkedList::Resume* key = arr[i];
-        int j = i - 1;
-        while (j >= 0 && arr[j]->name > key->name) { arr[j + 1] = arr[j]; --j; }
-        arr[j + 1] = key;
-    }
+// compiles `text`, printing the error on failure
+static bool compile_query(Query& q, const std::string& text, Query::Target target, unsigned fields) {
+    std::string error;
+    if (q.compile(text, target, fields, error)) return true;
+    std::cout << "[x] " << error << "\n";
+    return false;
 }
 
-static void sort_job_ptrs_by_title(const JobLinkedList::Job** arr, int n) {
-    for (int i = 1; i < n; ++i) {
-        const JobLinkedList::Job* key = arr[i];
-        int j = i - 1;
-        while (j >= 0 && arr[j]->title > key->title) { arr[j + 1] = arr[j]; --j; }
-        arr[j + 1] = key;
-    }
-}
 
 //  PERF HELPERS  
 
@@ -192,6 +151,31 @@ static void perf_array_quick_by_name(ResumeLinkedList::Resume* a, int n) {
     }
 }
 
+// Key sort by name: name keys sorted as (key, index) pairs in parallel,
+// then the records are moved into place once, following permutation cycles
+static void perf_array_key_sort_by_name(ResumeLinkedList::Resume* a, int n) {
+    if (n <= 1) return;
+    std::vector<TextView> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = TextView{ a[i].name.data(), a[i].name.size() };
+    std::vector<std::uint32_t> order;
+    keysort::order(keys, false, 0, order);
+
+    // slot i receives a[order[i]]
+    std::vector<bool> placed(n, false);
+    for (int start = 0; start < n; ++start) {
+        if (placed[start] || (int)order[start] == start) { placed[start] = true; continue; }
+        ResumeLinkedList::Resume held = std::move(a[start]);
+        int cur = start;
+        while ((int)order[cur] != start) {
+            a[cur] = std::move(a[order[cur]]);
+            placed[cur] = true;
+            cur = (int)order[cur];
+        }
+        a[cur] = std::move(held);
+        placed[cur] = true;
+    }
+}
+
 // Linear search by exact name on array
 static const ResumeLinkedList::Resume*
 perf_array_find_by_name(const ResumeLinkedList::Resume* a, int n, const std::string& name) {
@@ -220,13 +204,38 @@ static void printMenu() {
         << "6) Search job by ID\n"
         << "7) Search jobs by KEYWORD (paged x3)\n"
         << "8) Performance comparison (LL vs Array)\n"
-        << "9) Array (load → quicksort → top 5)\n"
+        << "9) Array (load → name index → top 5)\n"
+        << "10) Match ALL resumes -> jobs (parallel, top 3)\n"
+        << "11) Approximate match ALL (MinHash/LSH vs exact)\n"
+        << "12) Stream-match resume.csv -> file (bounded memory, top 3)\n"
+        << "13) Weighted match ALL (TF-IDF cosine, top 3)\n"
+        << "14) Dense match ALL (hashed embeddings, SIMD all-pairs, top 3)\n"
         << "0) Exit\n> ";
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // --serve / --loadgen: match server and its client (utils/MatchServer.h);
+    // any other argument selects the headless batch mode (utils/BatchRunner.h)
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        MatchServer::Options opt;
+        if (!MatchServer::parseArgs(argc, argv, opt)) return 1;
+        return MatchServer::serve(opt);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--loadgen") {
+        MatchServer::LoadOptions opt;
+        if (!MatchServer::parseLoadArgs(argc, argv, opt)) return 1;
+        return MatchServer::loadgen(opt);
+    }
+    if (argc > 1) {
+        BatchRunner::Options opt;
+        if (!BatchRunner::parseArgs(argc, argv, opt)) return 1;
+        return BatchRunner::run(opt);
+    }
+
     JobLinkedList     jobs;
     ResumeLinkedList  resumes;
+    WeightedIndex     weighted;   // TF-IDF vectors of both lists, built by option 1
+    DenseEmbedding    dense;      // hashed embeddings of those vectors, built by option 14
 
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
@@ -240,13 +249,28 @@ int main() {
 
         switch (choice) {
         case 1: {
-            bool okR = CsvReader::loadResumes("data/resume.csv", resumes);
-            bool okJ = CsvReader::loadJobs("data/job_description.csv", jobs);
-            (void)okR; (void)okJ;
+            const std::string resumesCsv = "data/resume.csv";
+            const std::string jobsCsv = "data/job_description.csv";
+            const std::string snapshot = "data/dataset.snap";
+
+            auto t0 = std::chrono::high_resolution_clock::now();
+            const Snapshot::LoadResult load = Snapshot::loadOrParse(snapshot, resumesCsv, jobsCsv, resumes, jobs);
+            // name/title orders for the sorted listings (3, 5, 7)
+            resumes.byName();
+            jobs.byTitle();
+            weighted.build(resumes, jobs);
+            dense.clear();   // rebuilt from the new vectors by option 14
+            auto t1 = std::chrono::high_resolution_clock::now();
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
 
             print_hr("LOAD SUMMARY");
             std::cout << "[Done] resumes loaded : " << resumes.size() << "\n";
             std::cout << "[Done] jobs loaded    : " << countJobs(jobs) << "\n";
+            if (load.fromSnapshot)
+                std::cout << "[Done] from snapshot " << snapshot << " in " << ms << " ms\n";
+            else
+                std::cout << "[Done] parsed CSVs in " << ms << " ms"
+                << (load.saved ? " (snapshot saved)" : "") << "\n";
 
             int shown = 0;
             std::cout << "\n// show two examples from resumes\n";
@@ -263,87 +287,46 @@ int main() {
 
         case 2: {
             print_hr("Show resumes (5 examples)");
-            int shown = 0;
-            resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-                if (shown < 5) { print_resume_row(r); ++shown; }
-                });
+            // each page continues from the cursor instead of re-walking the list
+            ResumeLinkedList::Cursor at = resumes.cursor();
+            resumes.page(at, 5, print_resume_row);
 
-            std::size_t printed = 5;
-            while (printed < resumes.size()) {
+            while (!at.atEnd()) {
                 std::cout << "\nShow 5 more? (y/n): ";
                 std::string ans; std::getline(std::cin, ans);
                 if (ans.empty() || (ans[0] != 'y' && ans[0] != 'Y')) break;
 
-                std::size_t i = 0;
-                resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-                    if (i >= printed && i < printed + 5) print_resume_row(r);
-                    ++i;
-                    });
-                printed += 5;
+                resumes.page(at, 5, print_resume_row);
             }
             break;
         }
 
         case 3: {
             print_hr("Filter resumes by SKILL and sort by name");
-            std::cout << "Skill keyword (e.g., SQL, Python, Excel): ";
-            std::string kw; std::getline(std::cin, kw); kw = lower_copy(kw);
+            std::cout << "Skill keyword or query (e.g., SQL, skill:python NOT name:intern): ";
+            std::string kw; std::getline(std::cin, kw);
 
-            int count = 0;
-            resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-                std::string s = lower_copy(r.skills);
-                if (s.find(kw) != std::string::npos) ++count;
-                });
+            Query rq;
+            if (!compile_query(rq, kw, Query::Target::Resumes, Query::Skills)) break;
+            PagedResults<const ResumeLinkedList::Resume*> rows;
+            int count = (int)rq.run(resumes, rows, Query::Order::Key);
 
             if (count == 0) { std::cout << "[i] 0 resumes matched \"" << kw << "\".\n"; break; }
 
-            const ResumeLinkedList::Resume** rows = new const ResumeLinkedList::Resume * [count];
-            int idx = 0;
-            resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-                if (idx < count) {
-                    std::string s = lower_copy(r.skills);
-                    if (s.find(kw) != std::string::npos) rows[idx++] = &r;
-                }
-                });
-
-            sort_resume_ptrs_by_name(rows, count);
-
             std::cout << "[i] " << count << " resumes matched \"" << kw << "\".\n";
             std::cout << "---- Sorted by name (top 3) ----\n";
             int top = (count < 3 ? count : 3);
             for (int i = 0; i < top; ++i) { std::cout << "  " << (i + 1) << ") "; print_resume_row(*rows[i]); }
 
             print_hr("Jobs requiring the same skill");
-            int jcount = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                std::string req = lower_copy(j.required);
-                if (req.find(kw) != std::string::npos) ++jcount;
-                });
-
-            if (jcount == 0) { std::cout << "[i] No job required \"" << kw << "\".\n"; delete[] rows; break; }
-
-            const JobLinkedList::Job** matches = new const JobLinkedList::Job * [jcount];
-            int jidx = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                if (jidx < jcount) {
-                    std::string req = lower_copy(j.required);
-                    if (req.find(kw) != std::string::npos) matches[jidx++] = &j;
-                }
-                });
+            Query jq;
+            if (!compile_query(jq, kw, Query::Target::Jobs, Query::Required)) break;
+            PagedResults<const JobLinkedList::Job*> matches;
+            int jcount = (int)jq.run(jobs, matches);
 
-            int i = 0, page = 1;
-            while (i < jcount) {
-                int take = ((jcount - i) < 3 ? (jcount - i) : 3);
-                std::cout << "\n--- Results page " << page << " -----------------------------\n";
-                std::cout << "ID     Title                                   Required\n";
-                std::cout << "----------------------------------------------------------\n";
-                for (int k = 0; k < take; ++k) print_job_row(*matches[i + k]);
-                i += take; ++page;
-                if (i < jcount && !ask_yes_no()) break;
-            }
+            if (jcount == 0) { std::cout << "[i] No job required \"" << kw << "\".\n"; break; }
 
-            delete[] matches;
-            delete[] rows;
+            show_job_pages(matches);
             break;
         }
 
@@ -352,82 +335,41 @@ int main() {
             std::cout << "Skill keyword to pick a sample resume (e.g., SQL): ";
             std::string kw; std::getline(std::cin, kw); kw = lower_copy(kw);
 
-            const ResumeLinkedList::Resume* chosen = nullptr;
-            resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-                if (!chosen) {
-                    std::string s = lower_copy(r.skills);
-                    if (s.find(kw) != std::string::npos) chosen = &r;
-                }
-                });
+            std::vector<const ResumeLinkedList::Resume*> picks;
+            const ResumeLinkedList::Resume* chosen =
+                resumes.searchBySkill(kw, picks) ? picks.front() : nullptr;
             if (!chosen) { std::cout << "[i] No resume contained \"" << kw << "\".\n"; break; }
 
-            int jcount = (int)countJobs(jobs);
-            if (jcount == 0) { std::cout << "[i] No jobs to match.\n"; break; }
-
-            struct Scored { const JobLinkedList::Job* j; double score; };
-            Scored* scored = new Scored[jcount];
-            int sidx = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                double s = jaccard_skills(chosen->skills, j.required);
-                if (sidx < jcount) { scored[sidx].j = &j; scored[sidx].score = s; ++sidx; }
-                });
+            if (jobs.rowCount() == 0) { std::cout << "[i] No jobs to match.\n"; break; }
 
-            // selection sort by descending score
-            for (int a = 0; a < sidx - 1; ++a) {
-                int best = a;
-                for (int b = a + 1; b < sidx; ++b)
-                    if (scored[b].score > scored[best].score) best = b;
-                if (best != a) { Scored t = scored[a]; scored[a] = scored[best]; scored[best] = t; }
-            }
+            // popcount Jaccard over every job's skill bitset, best 3 kept on a heap
+            std::vector<MatchLogic::ScoredJob> top;
+            MatchLogic::topJobsForResume(*chosen, jobs, 3, top);
 
             std::cout << "\n--- Match (1 resume -> top 3 jobs) ---\n";
             std::cout << "Resume  [" << chosen->id << "]  Name=\"" << chosen->name
                 << "\"  Skills=\"" << preview(chosen->skills, 68) << "\"\n";
-            int take = (sidx < 3 ? sidx : 3);
-            for (int i2 = 0; i2 < take; ++i2) {
-                const Scored& s = scored[i2];
-                std::cout << "  " << (i2 + 1) << ") [Job " << s.j->id << "]  score=" << s.score
-                    << "  Title=\"" << preview(s.j->title, 40) << "\"\n"
-                    << "     Required=\"" << preview(s.j->required, 60) << "\"\n";
+            for (std::size_t i2 = 0; i2 < top.size(); ++i2) {
+                const MatchLogic::ScoredJob& s = top[i2];
+                std::cout << "  " << (i2 + 1) << ") [Job " << s.job->id << "]  score=" << s.score
+                    << "  Title=\"" << preview(s.job->title, 40) << "\"\n"
+                    << "     Required=\"" << preview(s.job->required, 60) << "\"\n";
             }
-
-            delete[] scored;
             break;
         }
 
         case 5: {
             print_hr("Show jobs by TITLE keyword");
-            std::cout << "Title keyword: ";
-            std::string kw; std::getline(std::cin, kw); kw = lower_copy(kw);
+            std::cout << "Title keyword or query: ";
+            std::string kw; std::getline(std::cin, kw);
 
-            int jcount = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                std::string t = lower_copy(j.title);
-                if (t.find(kw) != std::string::npos) ++jcount;
-                });
+            Query q;
+            if (!compile_query(q, kw, Query::Target::Jobs, Query::Title)) break;
+            PagedResults<const JobLinkedList::Job*> found;
+            int jcount = (int)q.run(jobs, found, Query::Order::Key);
             if (jcount == 0) { std::cout << "[i] No jobs matched that title keyword.\n"; break; }
 
-            const JobLinkedList::Job** found = new const JobLinkedList::Job * [jcount];
-            int fidx = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                if (fidx < jcount) {
-                    std::string t = lower_copy(j.title);
-                    if (t.find(kw) != std::string::npos) found[fidx++] = &j;
-                }
-                });
-            sort_job_ptrs_by_title(found, jcount);
-
-            int i = 0, page = 1;
-            while (i < jcount) {
-                int take = ((jcount - i) < 3 ? (jcount - i) : 3);
-                std::cout << "\n--- Results page " << page << " -----------------------------\n";
-                std::cout << "ID     Title                                   Required\n";
-                std::cout << "----------------------------------------------------------\n";
-                for (int k = 0; k < take; ++k) print_job_row(*found[i + k]);
-                i += take; ++page;
-                if (i < jcount && !ask_yes_no()) break;
-            }
-            delete[] found;
+            show_job_pages(found);
             break;
         }
 
@@ -443,39 +385,16 @@ int main() {
 
         case 7: {
             print_hr("Search jobs by KEYWORD (paged x3)");
-            std::cout << "Keyword (title/required): ";
-            std::string kw; std::getline(std::cin, kw); kw = lower_copy(kw);
+            std::cout << "Keyword or query (title/required, e.g. title:engineer AND skill:sql): ";
+            std::string kw; std::getline(std::cin, kw);
 
-            int rcount = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                std::string t = lower_copy(j.title);
-                std::string r = lower_copy(j.required);
-                if (t.find(kw) != std::string::npos || r.find(kw) != std::string::npos) ++rcount;
-                });
+            Query q;
+            if (!compile_query(q, kw, Query::Target::Jobs, Query::Title | Query::Required)) break;
+            PagedResults<const JobLinkedList::Job*> results;
+            int rcount = (int)q.run(jobs, results, Query::Order::Key);
             if (rcount == 0) { std::cout << "[i] No jobs matched \"" << kw << "\".\n"; break; }
 
-            const JobLinkedList::Job** results = new const JobLinkedList::Job * [rcount];
-            int ridx = 0;
-            jobs.forEach([&](const JobLinkedList::Job& j) {
-                if (ridx < rcount) {
-                    std::string t = lower_copy(j.title);
-                    std::string r = lower_copy(j.required);
-                    if (t.find(kw) != std::string::npos || r.find(kw) != std::string::npos) results[ridx++] = &j;
-                }
-                });
-            sort_job_ptrs_by_title(results, rcount);
-
-            int i = 0, page = 1;
-            while (i < rcount) {
-                int take = ((rcount - i) < 3 ? (rcount - i) : 3);
-                std::cout << "\n--- Results page " << page << " -----------------------------\n";
-                std::cout << "ID     Title                                   Required\n";
-                std::cout << "----------------------------------------------------------\n";
-                for (int k = 0; k < take; ++k) print_job_row(*results[i + k]);
-                i += take; ++page;
-                if (i < rcount && !ask_yes_no()) break;
-            }
-            delete[] results;
+            show_job_pages(results);
             break;
         }
 
@@ -489,8 +408,11 @@ int main() {
 
             ResumeLinkedList::Resume* arr_bubble = new ResumeLinkedList::Resume[n];
             ResumeLinkedList::Resume* arr_quick = new ResumeLinkedList::Resume[n];
+            ResumeLinkedList::Resume* arr_keys = new ResumeLinkedList::Resume[n];
             perf_copy_list_to_array(resumes, arr_bubble, n);
             perf_copy_list_to_array(resumes, arr_quick, n);
+            perf_copy_list_to_array(resumes, arr_keys, n);
+            ResumeLinkedList ll_keys = resumes.clone();
 
             using clock = std::chrono::high_resolution_clock;
 
@@ -503,9 +425,17 @@ int main() {
             auto q0 = clock::now(); perf_array_quick_by_name(arr_quick, (int)n); auto q1 = clock::now();
             auto qs_ms = std::chrono::duration_cast<std::chrono::milliseconds>(q1 - q0).count();
 
+            auto k0 = clock::now(); ll_keys.sortByName(); auto k1 = clock::now();
+            auto lk_ms = std::chrono::duration_cast<std::chrono::milliseconds>(k1 - k0).count();
+
+            auto m0 = clock::now(); perf_array_key_sort_by_name(arr_keys, (int)n); auto m1 = clock::now();
+            auto ak_ms = std::chrono::duration_cast<std::chrono::milliseconds>(m1 - m0).count();
+
             std::cout << "[Sort] LinkedList merge sort : " << ll_ms << " ms\n";
             std::cout << "[Sort] Array bubble sort     : " << bs_ms << " ms\n";
             std::cout << "[Sort] Array quick sort      : " << qs_ms << " ms\n";
+            std::cout << "[Sort] LinkedList key sort   : " << lk_ms << " ms  (parallel radix on folded name keys)\n";
+            std::cout << "[Sort] Array key sort        : " << ak_ms << " ms\n";
 
             std::string needle = (n ? arr_quick[n - 1].name : std::string());
             auto s0 = clock::now(); auto* lhit = perf_list_find_by_name(resumes, needle); auto s1 = clock::now();
@@ -523,34 +453,232 @@ int main() {
             std::cout << "[Mem] Array      ~ " << (arr_bytes / 1024) << " KB  (" << resume_sz << " bytes per element)\n";
             std::cout << "      (String internals/allocator overhead ignored for both.)\n";
 
-            delete[] arr_bubble; delete[] arr_quick;
+            delete[] arr_bubble; delete[] arr_quick; delete[] arr_keys;
             break;
         }
 
         case 9: {
-            print_hr("Array demo (load → quicksort → top 5)");
+            print_hr("Array demo (load → name index → top 5)");
             static array2::ResumeArray arr;  
             int loaded = 0;
 
-            arr = array2::ResumeArray(); 
+            arr.clear();
             if (!arr.loadFromCsv("data/resume.csv", &loaded) || loaded == 0) {
                 std::cout << "[x] Failed to load any rows from data/resume.csv\n";
                 break;
             }
             std::cout << "[Array] loaded: " << loaded
-                << " rows (kMax=" << array2::ResumeArray::kMax << ")\n";
+                << " rows (" << arr.memoryBytes() / 1024 << " KB in columns)\n";
 
             auto t0 = std::chrono::high_resolution_clock::now();
-            arr.quickSortByName();
+            arr.orderByName();
             auto t1 = std::chrono::high_resolution_clock::now();
             auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
 
-            std::cout << "[Array] quickSortByName time: " << ms << " ms\n";
+            std::cout << "[Array] orderByName time: " << ms << " ms\n";
             std::cout << "---- Top 5 by name ----\n";
             arr.displayTop(std::cout, 5);
             break;
         }
 
+        case 10: {
+            print_hr("Match ALL resumes -> jobs (parallel)");
+            if (resumes.size() == 0 || countJobs(jobs) == 0) { std::cout << "[i] Load data first (option 1).\n"; break; }
+
+            std::vector<MatchLogic::ResumeMatches> results;
+            auto t0 = std::chrono::high_resolution_clock::now();
+            MatchLogic::matchAllParallel(resumes, jobs, 3, 0, results);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+
+            std::size_t matched = 0;
+            for (const auto& m : results) if (!m.top.empty()) ++matched;
+            std::cout << "[Match] " << results.size() << " resumes x " << countJobs(jobs)
+                << " jobs in " << ms << " ms  (" << matched << " with matches)\n";
+
+            std::vector<MatchLogic::ResumeMatches> head(results.begin(),
+                results.begin() + std::min<std::size_t>(5, results.size()));
+            std::cout << "---- First 5 resumes ----\n";
+            MatchLogic::writeMatches(std::cout, head);
+
+            if (ask_yes_no("Write all results to match_results.txt? (y/n): ")) {
+                std::ofstream f("match_results.txt");
+                if (!f.is_open()) { std::cout << "[x] cannot write match_results.txt\n"; break; }
+                MatchLogic::writeMatches(f, results);
+                std::cout << "[Done] wrote match_results.txt\n";
+            }
+            break;
+        }
+
+        case 11: {
+            print_hr("Approximate match ALL resumes -> jobs (MinHash/LSH)");
+            if (resumes.size() == 0 || jobs.rowCount() == 0) { std::cout << "[i] Load data first (option 1).\n"; break; }
+
+            const double threshold = 0.5;
+            std::cout << "Target recall for pairs with Jaccard >= " << threshold << " [0.9]: ";
+            std::string line; std::getline(std::cin, line);
+            double recall = 0.9;
+            if (!line.empty()) {
+                std::istringstream in(line);
+                if (!(in >> recall) || recall <= 0.0 || recall >= 1.0) {
+                    std::cout << "[x] recall must be between 0 and 1, using 0.9\n";
+                    recall = 0.9;
+                }
+            }
+
+            using clock = std::chrono::high_resolution_clock;
+            auto ms = [](clock::time_point a, clock::time_point b) {
+                return std::chrono::duration<double, std::milli>(b - a).count();
+            };
+
+            const MinHashLsh::Params params = MinHashLsh::tune(threshold, recall);
+            MinHashLsh lsh(params);
+            auto b0 = clock::now(); MatchLogic::buildJobLsh(jobs, lsh); auto b1 = clock::now();
+
+            std::vector<MatchLogic::JaccardMatches> exact, approx;
+            auto e0 = clock::now();
+            std::size_t exactPairs = MatchLogic::matchAllJaccard(resumes, jobs, nullptr, 3, 0, exact);
+            auto e1 = clock::now();
+            std::size_t approxPairs = MatchLogic::matchAllJaccard(resumes, jobs, &lsh, 3, 0, approx);
+            auto a1 = clock::now();
+
+            const double exactMs = ms(e0, e1), approxMs = ms(e1, a1);
+            std::cout << "[LSH] " << params.bands << " bands x " << params.rows << " rows"
+                << "  (expected recall at " << threshold << ": "
+                << MinHashLsh::collisionProbability(threshold, params.bands, params.rows)
+                << "), index built in " << ms(b0, b1) << " ms\n";
+            std::cout << "[Exact ] " << exactPairs << " pairs scored in " << exactMs << " ms\n";
+            std::cout << "[Approx] " << approxPairs << " pairs scored in " << approxMs << " ms"
+                << "  (" << (double)approxPairs / (double)exact.size() << " candidates/resume)\n";
+            std::cout << "[Result] speedup " << (approxMs > 0 ? exactMs / approxMs : 0.0)
+                << "x, recall@3 " << MatchLogic::recallAtK(exact, approx) << "\n";
+
+            std::cout << "---- First 5 resumes (approximate) ----\n";
+            for (std::size_t i = 0; i < approx.size() && i < 5; ++i) {
+                std::cout << "Candidate: " << approx[i].resume->name << "\n";
+                for (const auto& h : approx[i].top)
+                    std::cout << "  - " << h.job->title << "  (jaccard: " << h.score << ")\n";
+            }
+            break;
+        }
+
+        case 12: {
+            print_hr("Stream-match resume.csv -> jobs (bounded memory)");
+            // only the jobs are held; resumes are read, matched and written a window at a time
+            const std::string resumesCsv = "data/resume.csv";
+            const std::string outPath = "match_stream.txt";
+            if (jobs.rowCount() == 0 && !CsvReader::loadJobsParallel("data/job_description.csv", jobs)) {
+                std::cout << "[x] Failed to load data/job_description.csv\n";
+                break;
+            }
+
+            std::ofstream f(outPath);
+            if (!f.is_open()) { std::cout << "[x] cannot write " << outPath << "\n"; break; }
+
+            MatchLogic::StreamStats st;
+            auto t0 = std::chrono::high_resolution_clock::now();
+            bool ok = MatchLogic::streamMatch(resumesCsv, jobs, 3, 0, 4u << 20, f, &st);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+            if (!ok) { std::cout << "[x] No resumes read from " << resumesCsv << "\n"; break; }
+
+            std::cout << "[Stream] " << st.resumes << " resumes x " << jobs.rowCount() << " jobs in "
+                << ms << " ms  (" << st.matched << " with matches)\n";
+            std::cout << "[Stream] " << st.batches << " batches, at most " << st.largestBatch
+                << " resumes in memory\n";
+            std::cout << "[Done] wrote " << outPath << "\n";
+            break;
+        }
+
+        case 13: {
+            print_hr("Weighted match ALL resumes -> jobs (TF-IDF cosine)");
+            if (resumes.size() == 0 || jobs.rowCount() == 0) { std::cout << "[i] Load data first (option 1).\n"; break; }
+
+            using clock = std::chrono::high_resolution_clock;
+            auto ms = [](clock::time_point a, clock::time_point b) {
+                return std::chrono::duration<double, std::milli>(b - a).count();
+            };
+
+            // option 12 may have loaded the jobs alone since the last build
+            auto b0 = clock::now();
+            if (weighted.resumeCount() != resumes.rowCount() || weighted.jobCount() != jobs.rowCount()) {
+                weighted.build(resumes, jobs);
+                dense.clear();
+            }
+            auto b1 = clock::now();
+
+            std::vector<MatchLogic::WeightedMatches> results;
+            std::size_t pairs = MatchLogic::matchAllWeighted(resumes, jobs, weighted, 3, 0, results);
+            auto w1 = clock::now();
+            std::vector<MatchLogic::ResumeMatches> overlap;
+            MatchLogic::matchAllParallel(resumes, jobs, 3, 0, overlap);
+            auto o1 = clock::now();
+
+            const double allPairs = (double)resumes.rowCount() * (double)jobs.rowCount();
+            std::cout << "[TF-IDF] " << weighted.termCount() << " phrases weighted, index ready in "
+                << ms(b0, b1) << " ms\n";
+            std::cout << "[TF-IDF] " << results.size() << " resumes in " << ms(b1, w1) << " ms, "
+                << pairs << " pairs touched (" << 100.0 * pairs / allPairs << "% of all)\n";
+            std::cout << "[Overlap] same run with equal weights in " << ms(w1, o1) << " ms\n";
+
+            const TokenDictionary& dict = TokenDictionary::global();
+            std::cout << "---- First 5 resumes (phrase idf, 0 = no job lists it) ----\n";
+            for (std::size_t i = 0; i < results.size() && i < 5; ++i) {
+                const ResumeLinkedList::Resume& r = *results[i].resume;
+                std::cout << "Candidate: " << r.name << "\n  idf:";
+                for (TokenId id : r.skillIds) std::cout << " " << dict.text(id) << "=" << weighted.idf(id);
+                std::cout << "\n";
+                if (results[i].top.empty()) std::cout << "  - no matches\n";
+                for (const auto& h : results[i].top)
+                    std::cout << "  - " << h.job->title << "  (cosine: " << h.score << ")\n";
+            }
+            break;
+        }
+
+        case 14: {
+            print_hr("Dense match ALL resumes -> jobs (hashed embeddings)");
+            if (resumes.size() == 0 || jobs.rowCount() == 0) { std::cout << "[i] Load data first (option 1).\n"; break; }
+
+            using clock = std::chrono::high_resolution_clock;
+            auto ms = [](clock::time_point a, clock::time_point b) {
+                return std::chrono::duration<double, std::milli>(b - a).count();
+            };
+
+            auto b0 = clock::now();
+            if (weighted.resumeCount() != resumes.rowCount() || weighted.jobCount() != jobs.rowCount()) {
+                weighted.build(resumes, jobs);
+                dense.clear();
+            }
+            // cleared whenever `weighted` is rebuilt, so non-empty means current
+            if (dense.resumeCount() == 0)
+                dense.build(weighted);
+            auto b1 = clock::now();
+
+            std::vector<MatchLogic::WeightedMatches> results, exact;
+            MatchLogic::matchAllDense(resumes, jobs, dense, 3, 0, results);
+            auto d1 = clock::now();
+            MatchLogic::matchAllWeighted(resumes, jobs, weighted, 3, 0, exact);
+            auto w1 = clock::now();
+
+            const double pairs = (double)resumes.rowCount() * (double)jobs.rowCount();
+            const double denseMs = ms(b1, d1);
+            std::cout << "[Dense] " << dense.dims() << " dims, " << DenseEmbedding::kernelName()
+                << " kernel, embeddings ready in " << ms(b0, b1) << " ms\n";
+            std::cout << "[Dense] " << results.size() << " resumes x " << jobs.rowCount() << " jobs in "
+                << denseMs << " ms  (" << (denseMs > 0 ? pairs / denseMs / 1000.0 : 0.0) << " M pairs/s)\n";
+            std::cout << "[TF-IDF] posting lists (option 13) in " << ms(d1, w1) << " ms, recall@3 of dense "
+                << MatchLogic::recallAtK(exact, results, 1e-4) << "\n";
+
+            std::cout << "---- First 5 resumes (dense) ----\n";
+            for (std::size_t i = 0; i < results.size() && i < 5; ++i) {
+                std::cout << "Candidate: " << results[i].resume->name << "\n";
+                if (results[i].top.empty()) std::cout << "  - no matches\n";
+                for (const auto& h : results[i].top)
+                    std::cout << "  - " << h.job->title << "  (cosine: " << h.score << ")\n";
+            }
+            break;
+        }
+
         case 0: running = false; std::cout << "Goodbye.\n"; break;
         default: std::cout << "Invalid option.\n"; break;
         }
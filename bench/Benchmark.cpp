@@ -0,0 +1,420 @@
+// Non-interactive benchmark driver.
+//
+//   JobMatchingBench [--rows 10k,100k] [--reps 5] [--threads 0] [--pairs 1000]
+//                    [--recall 0.9] [--dir bench_data] [--out results.jsonl]
+//
+// For every row count it generates (once, then reuses) synthetic resume and
+// job CSVs, then times load, search, sort, single-resume top-K and all-pairs
+// matching (exact, and MinHash/LSH with its recall against exact) and the
+// incremental per-resume top-K table (full build vs one insert). Each
+// benchmark prints one JSON object per line to stdout (and to --out when
+// given); progress goes to stderr. 1M / 10M rows are supported via --rows
+// but not run by default (several GB of memory).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "SyntheticData.h"
+#include "arrays/ArrayJobs.h"
+#include "io/SingleColumnCsv.h"
+#include "io/CsvReader.h"
+#include "io/Snapshot.h"
+#include "models/JobLinkedList.h"
+#include "models/ResumeLinkedList.h"
+#include "utils/DenseEmbedding.h"
+#include "utils/MatchLogic.h"
+#include "utils/ThreadPool.h"
+#include "utils/TokenDictionary.h"
+#include "utils/WeightedIndex.h"
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<size_t> rows{ 10000, 100000 };
+        int reps = 5;
+        unsigned threads = 0;
+        size_t pairs = 1000;        // resumes matched against all jobs in all_pairs
+        size_t topKQueries = 100;   // resumes scored per top-K repetition
+        double recall = 0.9;        // LSH target at Jaccard >= 0.5
+        std::string dir = "bench_data";
+        std::string out;
+    };
+
+    static double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // Nearest-rank percentile of sorted samples.
+    static double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+        if (rank == 0) rank = 1;
+        return sorted[std::min(rank, sorted.size()) - 1];
+    }
+
+    class Report {
+    public:
+        explicit Report(const Options& o) : opt(o) {
+            if (!o.out.empty()) file.open(o.out, std::ios::app);
+        }
+
+        bool ok() const { return opt.out.empty() || file.good(); }
+
+        void emit(const std::string& bench, size_t rows, std::vector<double> samples,
+            const std::string& extra = std::string()) {
+            std::sort(samples.begin(), samples.end());
+            double sum = 0;
+            for (double s : samples) sum += s;
+
+            std::ostringstream os;
+            os.setf(std::ios::fixed);
+            os.precision(3);
+            os << "{\"bench\":\"" << bench << "\",\"rows\":" << rows
+                << ",\"threads\":" << threads() << ",\"samples\":" << samples.size()
+                << ",\"min_ms\":" << (samples.empty() ? 0.0 : samples.front())
+                << ",\"p50_ms\":" << percentile(samples, 50)
+                << ",\"p90_ms\":" << percentile(samples, 90)
+                << ",\"p99_ms\":" << percentile(samples, 99)
+                << ",\"max_ms\":" << (samples.empty() ? 0.0 : samples.back())
+                << ",\"mean_ms\":" << (samples.empty() ? 0.0 : sum / (double)samples.size());
+            if (!extra.empty()) os << "," << extra;
+            os << "}\n";
+
+            std::cout << os.str() << std::flush;
+            if (file.is_open()) file << os.str() << std::flush;
+        }
+
+    private:
+        unsigned threads() const { return opt.threads ? opt.threads : ThreadPool::defaultThreads(); }
+
+        const Options& opt;
+        std::ofstream file;
+    };
+
+    // "10000", "100k", "1M" -> count; 0 on a malformed value.
+    static size_t parseCount(const std::string& s) {
+        char* end = nullptr;
+        const double v = std::strtod(s.c_str(), &end);
+        if (end == s.c_str() || v <= 0) return 0;
+        double mul = 1;
+        if (*end == 'k' || *end == 'K') { mul = 1e3; ++end; }
+        else if (*end == 'm' || *end == 'M') { mul = 1e6; ++end; }
+        if (*end) return 0;
+        return (size_t)(v * mul);
+    }
+
+    static bool parseArgs(int argc, char** argv, Options& o) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string a = argv[i];
+            if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n"; return false; }
+            const std::string v = argv[++i];
+            if (a == "--rows") {
+                o.rows.clear();
+                std::stringstream ss(v);
+                std::string item;
+                while (std::getline(ss, item, ',')) {
+                    const size_t n = parseCount(item);
+                    if (!n) { std::cerr << "bad row count: " << item << "\n"; return false; }
+                    o.rows.push_back(n);
+                }
+            }
+            else if (a == "--reps") o.reps = std::max(1, std::atoi(v.c_str()));
+            else if (a == "--threads") o.threads = (unsigned)std::max(0, std::atoi(v.c_str()));
+            else if (a == "--pairs") o.pairs = parseCount(v);
+            else if (a == "--recall") {
+                o.recall = std::atof(v.c_str());
+                if (o.recall <= 0 || o.recall >= 1) { std::cerr << "recall must be in (0, 1)\n"; return false; }
+            }
+            else if (a == "--dir") o.dir = v;
+            else if (a == "--out") o.out = v;
+            else { std::cerr << "unknown option " << a << "\n"; return false; }
+        }
+        return !o.rows.empty();
+    }
+
+    static void makeDir(const std::string& path) {
+#if defined(_WIN32)
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    static bool fileExists(const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        return f.good();
+    }
+
+    static void runSize(const Options& opt, size_t n, Report& report) {
+        const std::string tag = std::to_string(n);
+        const std::string resumesCsv = opt.dir + "/resume_" + tag + ".csv";
+        const std::string jobsCsv = opt.dir + "/job_description_" + tag + ".csv";
+        const std::string snapshot = opt.dir + "/dataset_" + tag + ".snap";
+
+        if (!fileExists(resumesCsv) || !fileExists(jobsCsv)) {
+            std::cerr << "[bench] generating " << n << " rows in " << opt.dir << "\n";
+            makeDir(opt.dir);
+            if (!synth::writeResumes(resumesCsv, n) || !synth::writeJobs(jobsCsv, n)) {
+                std::cerr << "[bench] cannot write to " << opt.dir << "\n";
+                return;
+            }
+        }
+
+        ResumeLinkedList resumes;
+        JobLinkedList jobs;
+        std::vector<double> samples;
+
+        // ---- load ----
+        // The phrase dictionary is process-wide and never shrinks, so only
+        // the first load interns anything: it is timed and reported on its
+        // own (load_csv_first), and the reps all run with every phrase known.
+        std::cerr << "[bench] " << n << ": load_csv\n";
+        auto loadCsv = [&]() {
+            resumes.clear();   // freeing the previous rep is not part of the load
+            jobs.clear();
+            const auto t0 = Clock::now();
+            CsvReader::loadResumesParallel(resumesCsv, resumes, opt.threads);
+            CsvReader::loadJobsParallel(jobsCsv, jobs, opt.threads);
+            return msSince(t0);
+        };
+        const size_t knownBefore = TokenDictionary::global().size();
+        samples.assign(1, loadCsv());
+        report.emit("load_csv_first", n, samples,
+            "\"phrases_known_before\":" + std::to_string(knownBefore) +
+            ",\"phrases_interned\":" + std::to_string(TokenDictionary::global().size() - knownBefore));
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) samples.push_back(loadCsv());
+        report.emit("load_csv", n, samples, "\"dictionary\":\"warm\"");
+
+        if (Snapshot::save(snapshot, resumesCsv, jobsCsv, resumes, jobs)) {
+            std::cerr << "[bench] " << n << ": load_snapshot\n";
+            samples.clear();
+            for (int r = 0; r < opt.reps; ++r) {
+                resumes.clear();
+                jobs.clear();
+                const auto t0 = Clock::now();
+                Snapshot::load(snapshot, resumesCsv, jobsCsv, resumes, jobs);
+                samples.push_back(msSince(t0));
+            }
+            report.emit("load_snapshot", n, samples);
+        }
+        if (resumes.size() == 0 || jobs.rowCount() == 0) {
+            std::cerr << "[bench] " << n << ": nothing loaded\n";
+            return;
+        }
+
+        // ---- search ----
+        static const char* const kKeywords[] = { "sql", "python", "docker", "scrum", "power bi" };
+        std::cerr << "[bench] " << n << ": search\n";
+        std::vector<const ResumeLinkedList::Resume*> resumeHits;
+        std::vector<const JobLinkedList::Job*> jobHits;
+        size_t hits = 0;
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) {
+            for (const char* kw : kKeywords) {
+                const auto t0 = Clock::now();
+                hits += resumes.searchBySkill(kw, resumeHits);
+                samples.push_back(msSince(t0));
+            }
+        }
+        report.emit("search_resume_skill", n, samples, "\"hits\":" + std::to_string(hits / opt.reps));
+
+        hits = 0;
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) {
+            for (const char* kw : kKeywords) {
+                const auto t0 = Clock::now();
+                hits += jobs.searchAllByKeyword(kw, JobLinkedList::Field::TitleOrRequired, jobHits);
+                samples.push_back(msSince(t0));
+            }
+        }
+        report.emit("search_job_keyword", n, samples, "\"hits\":" + std::to_string(hits / opt.reps));
+
+        // ---- sort (copy made outside the timed region) ----
+        std::cerr << "[bench] " << n << ": sort_name\n";
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) {
+            ResumeLinkedList copy = resumes.clone();
+            const auto t0 = Clock::now();
+            copy.mergeSortByName();
+            samples.push_back(msSince(t0));
+        }
+        report.emit("sort_resume_name", n, samples);
+
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) {
+            ResumeLinkedList copy = resumes.clone();
+            const auto t0 = Clock::now();
+            copy.sortByName(opt.threads);
+            samples.push_back(msSince(t0));
+        }
+        report.emit("sort_resume_name_keys", n, samples);
+
+        // ---- one resume -> top 3 jobs (as menu option 4) ----
+        std::cerr << "[bench] " << n << ": topk_match\n";
+        std::vector<MatchLogic::ScoredJob> top;
+        const size_t queries = std::min(opt.topKQueries, resumes.rowCount());
+        const size_t stride = std::max<size_t>(1, resumes.rowCount() / std::max<size_t>(1, queries));
+        samples.clear();
+        for (int r = 0; r < opt.reps; ++r) {
+            for (size_t q = 0; q < queries; ++q) {
+                const auto& resume = resumes.resumeAtRow(q * stride);
+                const auto t0 = Clock::now();
+                MatchLogic::topJobsForResume(resume, jobs, 3, top);
+                samples.push_back(msSince(t0));
+            }
+        }
+        report.emit("topk_match", n, samples, "\"k\":3");
+
+        // ---- first `pairs` resumes x all jobs ----
+        const size_t pairs = std::min(opt.pairs, resumes.rowCount());
+        if (pairs > 0) {
+            std::cerr << "[bench] " << n << ": all_pairs (" << pairs << " resumes)\n";
+            ResumeLinkedList subset;
+            for (size_t i = 0; i < pairs; ++i) {
+                ResumeLinkedList::Resume copy = resumes.resumeAtRow(i);
+                subset.insertResume(std::move(copy));
+            }
+            std::vector<MatchLogic::ResumeMatches> results;
+            samples.clear();
+            for (int r = 0; r < opt.reps; ++r) {
+                const auto t0 = Clock::now();
+                MatchLogic::matchAllParallel(subset, jobs, 3, opt.threads, results);
+                samples.push_back(msSince(t0));
+            }
+            report.emit("all_pairs", n, samples,
+                "\"resumes\":" + std::to_string(pairs) + ",\"jobs\":" + std::to_string(jobs.rowCount()));
+
+            // phrase-id Jaccard: every job vs LSH candidates only
+            std::cerr << "[bench] " << n << ": jaccard exact / lsh\n";
+            std::vector<MatchLogic::JaccardMatches> exact, approx;
+            std::vector<double> exactSamples;
+            for (int r = 0; r < opt.reps; ++r) {
+                const auto t0 = Clock::now();
+                MatchLogic::matchAllJaccard(subset, jobs, nullptr, 3, opt.threads, exact);
+                exactSamples.push_back(msSince(t0));
+            }
+            report.emit("jaccard_exact", n, exactSamples, "\"resumes\":" + std::to_string(pairs));
+
+            const MinHashLsh::Params params = MinHashLsh::tune(0.5, opt.recall);
+            MinHashLsh lsh(params);
+            auto t0 = Clock::now();
+            MatchLogic::buildJobLsh(jobs, lsh);
+            report.emit("lsh_build", n, std::vector<double>{ msSince(t0) },
+                "\"bands\":" + std::to_string(params.bands) + ",\"band_rows\":" + std::to_string(params.rows));
+
+            size_t scored = 0;
+            samples.clear();
+            for (int r = 0; r < opt.reps; ++r) {
+                t0 = Clock::now();
+                scored = MatchLogic::matchAllJaccard(subset, jobs, &lsh, 3, opt.threads, approx);
+                samples.push_back(msSince(t0));
+            }
+            std::sort(exactSamples.begin(), exactSamples.end());
+            std::vector<double> sorted(samples);
+            std::sort(sorted.begin(), sorted.end());
+            std::ostringstream extra;
+            extra << "\"resumes\":" << pairs
+                << ",\"target_recall\":" << opt.recall
+                << ",\"recall_at_3\":" << MatchLogic::recallAtK(exact, approx)
+                << ",\"candidates_per_resume\":" << (double)scored / (double)pairs
+                << ",\"speedup_p50\":" << percentile(exactSamples, 50) / std::max(1e-9, percentile(sorted, 50));
+            report.emit("jaccard_lsh", n, samples, extra.str());
+
+            // TF-IDF cosine: posting lists vs the dense SIMD all-pairs kernel
+            std::cerr << "[bench] " << n << ": tfidf postings / dense\n";
+            WeightedIndex weighted;
+            t0 = Clock::now();
+            weighted.build(subset, jobs);
+            DenseEmbedding dense;
+            dense.build(weighted);
+            report.emit("dense_build", n, std::vector<double>{ msSince(t0) },
+                "\"dims\":" + std::to_string(dense.dims()));
+
+            std::vector<MatchLogic::WeightedMatches> tfidf, denseHits;
+            std::vector<double> tfidfSamples;
+            for (int r = 0; r < opt.reps; ++r) {
+                t0 = Clock::now();
+                MatchLogic::matchAllWeighted(subset, jobs, weighted, 3, opt.threads, tfidf);
+                tfidfSamples.push_back(msSince(t0));
+            }
+            report.emit("tfidf_postings", n, tfidfSamples, "\"resumes\":" + std::to_string(pairs));
+
+            samples.clear();
+            for (int r = 0; r < opt.reps; ++r) {
+                t0 = Clock::now();
+                MatchLogic::matchAllDense(subset, jobs, dense, 3, opt.threads, denseHits);
+                samples.push_back(msSince(t0));
+            }
+            std::ostringstream denseExtra;
+            denseExtra << "\"resumes\":" << pairs << ",\"kernel\":\"" << DenseEmbedding::kernelName()
+                << "\",\"recall_at_3\":" << MatchLogic::recallAtK(tfidf, denseHits, 1e-4);
+            report.emit("dense_all_pairs", n, samples, denseExtra.str());
+
+            // materialized top-3 table over the same resumes: full build,
+            // then one job or resume added at a time
+            std::cerr << "[bench] " << n << ": match_table\n";
+            DynamicArray<std::string> jobText, resText;
+            ioutils::readSingleColumn(jobsCsv, "job_description", jobText);
+            ioutils::readSingleColumn(resumesCsv, "resume", resText);
+            const size_t delta = std::min<size_t>(100, std::min(jobText.size(), resText.size()) / 10);
+            if (delta > 0 && resText.size() > pairs) {
+                arrayjobs::Store store;
+                for (size_t i = 0; i + delta < jobText.size(); ++i) arrayjobs::insertJob(store, jobText[i]);
+                for (size_t i = 0; i < pairs; ++i) arrayjobs::insertResume(store, resText[i]);
+
+                t0 = Clock::now();
+                arrayjobs::buildMatches(store, 3);
+                report.emit("match_table_build", n, std::vector<double>{ msSince(t0) },
+                    "\"resumes\":" + std::to_string(pairs) + ",\"jobs\":" + std::to_string(store.jobs.size()));
+
+                std::vector<double> jobSamples, resSamples;
+                for (size_t i = 0; i < delta; ++i) {
+                    t0 = Clock::now();
+                    arrayjobs::insertJob(store, jobText[jobText.size() - delta + i]);
+                    jobSamples.push_back(msSince(t0));
+                    t0 = Clock::now();
+                    arrayjobs::insertResume(store, resText[std::min(resText.size() - 1, pairs + i)]);
+                    resSamples.push_back(msSince(t0));
+                }
+                report.emit("match_table_add_job", n, jobSamples, "\"k\":3");
+                report.emit("match_table_add_resume", n, resSamples, "\"k\":3");
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::cerr << "usage: JobMatchingBench [--rows 10k,100k,1M,10M] [--reps N] [--threads N]\n"
+            "                        [--pairs N] [--recall R] [--dir DIR] [--out FILE.jsonl]\n";
+        return 2;
+    }
+
+    Report report(opt);
+    if (!report.ok()) {
+        std::cerr << "cannot open " << opt.out << "\n";
+        return 1;
+    }
+
+    for (size_t n : opt.rows) runSize(opt, n, report);
+    return 0;
+}
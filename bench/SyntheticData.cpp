@@ -0,0 +1,129 @@
+#include "SyntheticData.h"
+
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    struct Role {
+        const char* title;
+        std::vector<const char*> skills;
+    };
+
+    // Role families and their skill pools, as in the bundled datasets.
+    static const std::vector<Role>& roles() {
+        static const std::vector<Role> r = {
+            { "Data Analyst", { "SQL", "Excel", "Power BI", "Tableau", "Reporting", "Data Cleaning" } },
+            { "Data Scientist", { "Python", "Statistics", "Pandas", "SQL", "Machine Learning", "NLP", "Deep Learning" } },
+            { "Software Engineer", { "Java", "Spring Boot", "REST APIs", "Git", "Docker", "System Design", "Agile" } },
+            { "ML Engineer", { "Python", "TensorFlow", "Keras", "PyTorch", "MLOps", "Computer Vision", "Cloud" } },
+            { "Product Manager", { "Agile", "Scrum", "Stakeholder Management", "Product Roadmap", "User Stories" } },
+        };
+        return r;
+    }
+
+    static const char* const kFiller[] = {
+        "agent", "system", "staff", "quickly", "truth", "store", "better", "drop",
+        "senior", "scene", "prepare", "remember", "general", "word", "worry", "week",
+        "campaign", "read", "laugh", "national", "address", "almost", "third", "rich",
+        "phone", "during", "necessary", "talk", "ready", "evidence", "agreement", "military",
+        "future", "support", "blue", "tend", "fire", "property", "toward", "view",
+        "commercial", "together", "animal", "friend", "owner", "door", "research", "film",
+    };
+    const size_t kFillerCount = sizeof(kFiller) / sizeof(kFiller[0]);
+
+    class Gen {
+    public:
+        explicit Gen(std::uint64_t seed) : rng(seed) {}
+
+        size_t below(size_t n) { return (size_t)(rng() % n); }
+
+        const char* filler() { return kFiller[below(kFillerCount)]; }
+
+        // 3..6 filler words, capitalised, ending with a period.
+        void sentence(std::string& out) {
+            const size_t words = 3 + below(4);
+            for (size_t w = 0; w < words; ++w) {
+                std::string word = filler();
+                if (w == 0) word[0] = (char)(word[0] - 'a' + 'A');
+                else out.push_back(' ');
+                out += word;
+            }
+            out.push_back('.');
+        }
+
+        // A shuffled subset of the role's skills; with `noise`, a few filler
+        // words are mixed into the list like in resume.csv.
+        void skillList(const Role& role, bool noise, std::string& out) {
+            std::vector<const char*> picked(role.skills);
+            for (size_t k = picked.size(); k > 1; --k)   // Fisher-Yates, library-independent
+                std::swap(picked[k - 1], picked[below(k)]);
+            picked.resize(2 + below(picked.size() - 1));
+            if (noise) {
+                const size_t extra = below(4);
+                for (size_t k = 0; k < extra; ++k)
+                    picked.insert(picked.begin() + below(picked.size() + 1), filler());
+            }
+            for (size_t k = 0; k < picked.size(); ++k) {
+                if (k) out += ", ";
+                out += picked[k];
+            }
+        }
+
+        std::mt19937_64 rng;
+    };
+
+    template<typename Row>
+    static bool writeCsv(const std::string& path, const char* header, size_t rows, Row row) {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        std::string buf = "\xEF\xBB\xBF";
+        buf += header;
+        buf += "\n";
+        for (size_t i = 0; i < rows; ++i) {
+            buf.push_back('"');
+            row(buf);
+            buf += "\"\n";
+            if (buf.size() >= (1u << 20)) {
+                if (std::fwrite(buf.data(), 1, buf.size(), f) != buf.size()) { std::fclose(f); return false; }
+                buf.clear();
+            }
+        }
+        const bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+        return std::fclose(f) == 0 && ok;
+    }
+
+} // namespace
+
+bool synth::writeResumes(const std::string& path, size_t rows, std::uint64_t seed) {
+    Gen g(seed);
+    return writeCsv(path, "resume", rows, [&g](std::string& out) {
+        const Role& role = roles()[g.below(roles().size())];
+        out += "Experienced professional skilled in ";
+        g.skillList(role, true, out);
+        out += ". ";
+        const size_t sentences = 2 + g.below(2);
+        for (size_t s = 0; s < sentences; ++s) {
+            if (s) out.push_back(' ');
+            g.sentence(out);
+        }
+        });
+}
+
+bool synth::writeJobs(const std::string& path, size_t rows, std::uint64_t seed) {
+    Gen g(seed);
+    return writeCsv(path, "job_description", rows, [&g](std::string& out) {
+        const Role& role = roles()[g.below(roles().size())];
+        out += role.title;
+        out += " needed with experience in ";
+        g.skillList(role, false, out);
+        out += ". ";
+        const size_t sentences = 1 + g.below(3);
+        for (size_t s = 0; s < sentences; ++s) {
+            if (s) out.push_back(' ');
+            g.sentence(out);
+        }
+        });
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Deterministic generator for CSVs shaped like data/resume.csv and
+// data/job_description.csv: UTF-8 BOM, one-word header, one quoted sentence
+// per row built from the same five role families, skill phrases and filler
+// words, so extraction, indexing and matching see a realistic mix.
+namespace synth {
+
+    // Same seed and row count -> byte-identical file. Returns false on I/O error.
+    bool writeResumes(const std::string& path, size_t rows, std::uint64_t seed = 1);
+    bool writeJobs(const std::string& path, size_t rows, std::uint64_t seed = 2);
+
+} // namespace synth
@@ -2,32 +2,70 @@
 #include "arrays/ArraySearch.h"
 #include "arrays/ArraySimilarity.h"
 #include "io/SingleColumnCsv.h"
+#include "utils/TopK.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
 #include <string>
 
 
 namespace arrayjobs {
 
 
+static void job_added(Store& s, std::size_t j);
+static void resume_added(Store& s, std::size_t r);
+
+
+static void build_index(const DynamicArray<std::string>& rows, InvertedIndex& idx,
+DynamicArray<TokenIds>& ids){
+idx.clear(); ids.clear(); ids.reserve(rows.size());
+for(std::size_t i=0;i<rows.size();++i){
+idx.add(static_cast<InvertedIndex::Row>(i), rows[i]);
+TokenIds t; arrayalgo::splitUniqueIds(rows[i], t);
+ids.push_back(std::move(t));
+}
+}
+
+
 LoadStats load(Store& s){
 s.jobs.clear(); s.resumes.clear();
 bool ok1 = ioutils::readSingleColumn(s.jobsPath, "job_description", s.jobs);
 bool ok2 = ioutils::readSingleColumn(s.resPath, "resume", s.resumes);
+build_index(s.jobs, s.jobsIndex, s.jobTokens);
+build_index(s.resumes, s.resIndex, s.resTokens);
+buildMatches(s, s.matchK);
 return LoadStats{ok1, ok2, s.jobs.size(), s.resumes.size()};
 }
 
 
-void insertJob(Store& s, const std::string& text){ s.jobs.push_back(text); }
-void insertResume(Store& s, const std::string& text){ s.resumes.push_back(text); }
+void insertJob(Store& s, const std::string& text){
+s.jobsIndex.add(static_cast<InvertedIndex::Row>(s.jobs.size()), text);
+TokenIds t; arrayalgo::splitUniqueIds(text, t);
+s.jobTokens.push_back(std::move(t));
+s.jobs.push_back(text);
+if(s.matchK) job_added(s, s.jobs.size()-1);
+}
+void insertResume(Store& s, const std::string& text){
+s.resIndex.add(static_cast<InvertedIndex::Row>(s.resumes.size()), text);
+TokenIds t; arrayalgo::splitUniqueIds(text, t);
+s.resTokens.push_back(std::move(t));
+s.resumes.push_back(text);
+if(s.matchK) resume_added(s, s.resumes.size()-1);
+}
 
 
-std::size_t searchJobsByKeyword(const Store& s, const std::string& kw,
-DynamicArray<std::size_t>* sampleIdx,
-std::size_t maxSample){
+// Index candidates, re-checked against the pre-folded keyword only when the
+// index cannot answer exactly.
+static std::size_t search_indexed(const DynamicArray<std::string>& rows, const InvertedIndex& idx,
+const std::string& kw, DynamicArray<std::size_t>* sampleIdx, std::size_t maxSample){
 std::size_t hits=0;
 if(sampleIdx) sampleIdx->clear();
-for(std::size_t i=0;i<s.jobs.size();++i){
-if(arrayalgo::containsKeywordCI(s.jobs[i], kw)){
-if(sampleIdx && sampleIdx->size()<maxSample) sampleIdx->push_back(i);
+InvertedIndex::Postings cand;
+const bool exact = idx.candidates(kw, cand);
+const CiPattern pat(kw);
+for(InvertedIndex::Row r: cand){
+if(exact || pat.foundIn(rows[r])){
+if(sampleIdx && sampleIdx->size()<maxSample) sampleIdx->push_back(r);
 ++hits;
 }
 }
@@ -35,18 +73,17 @@ return hits;
 }
 
 
-std::size_t searchResumesByKeyword(const Store& s, const std::string& kw,
+std::size_t searchJobsByKeyword(const Store& s, const std::string& kw,
 DynamicArray<std::size_t>* sampleIdx,
 std::size_t maxSample){
-std::size_t hits=0;
-if(sampleIdx) sampleIdx->clear();
-for(std::size_t i=0;i<s.resumes.size();++i){
-if(arrayalgo::containsKeywordCI(s.resumes[i], kw)){
-if(sampleIdx && sampleIdx->size()<maxSample) sampleIdx->push_back(i);
-++hits;
+return search_indexed(s.jobs, s.jobsIndex, kw, sampleIdx, maxSample);
 }
-}
-return hits;
+
+
+std::size_t searchResumesByKeyword(const Store& s, const std::string& kw,
+DynamicArray<std::size_t>* sampleIdx,
+std::size_t maxSample){
+return search_indexed(s.resumes, s.resIndex, kw, sampleIdx, maxSample);
 }
 
 
@@ -56,31 +93,158 @@ outMatches.clear();
 if(resumeIndex1based==0 || resumeIndex1based> s.resumes.size()) return;
 
 
-const std::string& resumeText = s.resumes[resumeIndex1based-1];
-DynamicArray<std::string> Rset; arrayalgo::splitUniqueSorted(resumeText, Rset);
+// token ids were interned at load, so each score is an integer merge
+const TokenIds& Rset = s.resTokens[resumeIndex1based-1];
 
 
-struct Pair { std::size_t idx; double score; };
-DynamicArray<Pair> scores;
+// bounded heap: O(J log K), ties -> lower job index
+TopK<double> best(K);
+for(std::size_t i=0;i<s.jobs.size() && K>0;++i){
+best.offer(arrayalgo::jaccard(Rset, s.jobTokens[i]), i);
+}
 
 
-for(std::size_t i=0;i<s.jobs.size();++i){
-DynamicArray<std::string> Jset; arrayalgo::splitUniqueSorted(s.jobs[i], Jset);
-double sc = arrayalgo::jaccard(Rset, Jset);
-scores.push_back(Pair{i, sc});
+std::vector<TopK<double>::Entry> kept;
+best.take(kept);
+for(const auto& e : kept) outMatches.push_back(Match{e.id, e.score});
 }
 
 
-auto more = [](const Pair& a, const Pair& b){ return a.score > b.score; };
-scores.quicksort(more);
+// ---------------- incremental top-K table ----------------
+typedef std::vector<std::pair<std::uint32_t, std::uint32_t>> SharedCounts;
 
 
-for(std::size_t i=0;i<K && i<scores.size(); ++i){
-outMatches.push_back(Match{scores[i].idx, scores[i].score});
+static void add_postings(std::vector<std::vector<std::uint32_t>>& byToken, const TokenIds& ids, std::size_t row){
+for(TokenId id: ids){
+if(id>=byToken.size()) byToken.resize(static_cast<std::size_t>(id)+1);
+byToken[id].push_back(static_cast<std::uint32_t>(row));
 }
 }
 
 
+// (row, shared word count) for every row sharing a word with `ids`, in no
+// particular order. Counts go through `scratch` (grown to `rows`, left all zero), so the
+// cost follows the touched posting lists rather than the table size.
+static void shared_counts(const std::vector<std::vector<std::uint32_t>>& byToken, const TokenIds& ids,
+std::size_t rows, std::vector<std::uint32_t>& scratch, SharedCounts& out){
+if(scratch.size()<rows) scratch.resize(rows, 0);
+out.clear();
+for(TokenId id: ids){
+if(id>=byToken.size()) continue;
+for(std::uint32_t r: byToken[id]){
+if(scratch[r]++==0) out.push_back(std::make_pair(r, 0u));
+}
+}
+for(auto& rc: out){ rc.second = scratch[rc.first]; scratch[rc.first] = 0; }
+}
+
+
+// tokens::jaccard from an intersection size already counted
+static double jaccard_from_count(std::size_t inter, std::size_t a, std::size_t b){
+const std::size_t uni = a+b-inter;
+if(uni==0) return 0.0;
+return static_cast<double>(inter)/static_cast<double>(uni);
+}
+
+
+static bool better(const Match& a, const Match& b){
+return a.score>b.score || (a.score==b.score && a.jobIndex<b.jobIndex);
+}
+
+
+// Inserts m into a best-first list capped at K; false when it does not make the cut.
+static bool offer_sorted(std::vector<Match>& top, std::size_t K, const Match& m){
+if(top.size()>=K && !better(m, top.back())) return false;
+top.insert(std::upper_bound(top.begin(), top.end(), m, better), m);
+if(top.size()>K) top.pop_back();
+return true;
+}
+
+
+// Same list as topKJobsForResume: jobs sharing no word score 0, so they
+// only fill the tail, lowest index first.
+static void rank_resume(const Store& s, std::size_t r, std::vector<std::uint32_t>& scratch,
+std::vector<Match>& out){
+const TokenIds& R = s.resTokens[r];
+SharedCounts shared;
+shared_counts(s.jobsByToken, R, s.jobs.size(), scratch, shared);
+
+TopK<double> best(s.matchK);
+for(const auto& jc: shared){
+best.offer(jaccard_from_count(jc.second, R.size(), s.jobTokens[jc.first].size()), jc.first);
+}
+std::vector<TopK<double>::Entry> kept;
+best.take(kept);
+out.clear();
+for(const auto& e : kept) out.push_back(Match{e.id, e.score});
+
+if(out.size()>=s.matchK) return;
+std::sort(shared.begin(), shared.end());
+std::size_t next=0;
+for(std::size_t j=0;j<s.jobs.size() && out.size()<s.matchK;++j){
+while(next<shared.size() && shared[next].first<j) ++next;
+if(next<shared.size() && shared[next].first==j) continue;
+out.push_back(Match{j, 0.0});
+}
+}
+
+
+void buildMatches(Store& s, std::size_t K){
+s.matchK = K;
+s.topMatches.clear();
+s.jobsByToken.clear();
+s.resByToken.clear();
+s.sharedScratch.clear();
+if(K==0) return;
+
+for(std::size_t i=0;i<s.jobs.size();++i) add_postings(s.jobsByToken, s.jobTokens[i], i);
+for(std::size_t i=0;i<s.resumes.size();++i) add_postings(s.resByToken, s.resTokens[i], i);
+s.topMatches.resize(s.resumes.size());
+for(std::size_t r=0;r<s.resumes.size();++r) rank_resume(s, r, s.sharedScratch, s.topMatches[r]);
+}
+
+
+// A new job has the highest index, so it loses every tie. Only resumes
+// sharing a word with it can score above 0; it is scored against those
+// whose list is not full or whose K-th score sits below the Jaccard upper
+// bound min(|R|,|J|) / max(|R|,|J|).
+static void job_added(Store& s, std::size_t j){
+const TokenIds& J = s.jobTokens[j];
+add_postings(s.jobsByToken, J, j);
+
+SharedCounts shared;
+shared_counts(s.resByToken, J, s.resumes.size(), s.sharedScratch, shared);
+for(const auto& rc: shared){
+std::vector<Match>& top = s.topMatches[rc.first];
+const std::size_t rn = s.resTokens[rc.first].size();
+if(top.size()>=s.matchK){
+const double bound = static_cast<double>(std::min(rn, J.size()))/static_cast<double>(std::max(rn, J.size()));
+if(bound<=top.back().score) continue;
+}
+offer_sorted(top, s.matchK, Match{j, jaccard_from_count(rc.second, rn, J.size())});
+}
+
+// lists are only short while there are fewer than K jobs; then a zero
+// score still gets in
+if(s.jobs.size()<=s.matchK){
+std::sort(shared.begin(), shared.end());
+std::size_t next=0;
+for(std::size_t r=0;r<s.topMatches.size();++r){
+while(next<shared.size() && shared[next].first<r) ++next;
+if(next<shared.size() && shared[next].first==r) continue;
+offer_sorted(s.topMatches[r], s.matchK, Match{j, 0.0});
+}
+}
+}
+
+
+static void resume_added(Store& s, std::size_t r){
+add_postings(s.resByToken, s.resTokens[r], r);
+s.topMatches.resize(r+1);
+rank_resume(s, r, s.sharedScratch, s.topMatches[r]);
+}
+
+
 static std::size_t estimate_bytes(const DynamicArray<std::string>& arr){
 std::size_t bytes = sizeof(arr);
 for(std::size_t i=0;i<arr.size();++i) bytes += arr[i].capacity();
@@ -1,16 +1,37 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "arrays/DynamicArray.h"
+#include "utils/InvertedIndex.h"
+#include "utils/TokenDictionary.h"
 
 
 namespace arrayjobs {
 
 
+struct Match { std::size_t jobIndex; double score; };
+
+
 struct Store {
 DynamicArray<std::string> jobs;
 DynamicArray<std::string> resumes;
 std::string jobsPath{"data/job_description.csv"};
 std::string resPath{"data/resume.csv"};
+// keyword indexes (row = array index), built by load() and kept by insert*()
+InvertedIndex jobsIndex;
+InvertedIndex resIndex;
+// per-row interned word ids (row = array index), same lifetime as the indexes
+DynamicArray<TokenIds> jobTokens;
+DynamicArray<TokenIds> resTokens;
+// materialized top-K jobs per resume (best first), kept current by insert*()
+// after buildMatches(); matchK == 0 means no table is maintained
+std::size_t matchK{0};
+std::vector<std::vector<Match>> topMatches;
+// word id -> rows holding it, only built while a table is maintained
+std::vector<std::vector<std::uint32_t>> jobsByToken;
+std::vector<std::vector<std::uint32_t>> resByToken;
+std::vector<std::uint32_t> sharedScratch;   // per-row counters, all zero between updates
 };
 
 
@@ -33,11 +54,17 @@ DynamicArray<std::size_t>* sampleIdx = nullptr,
 std::size_t maxSample = 5);
 
 
-struct Match { std::size_t jobIndex; double score; };
 void topKJobsForResume(const Store& s, std::size_t resumeIndex1based, std::size_t K,
 DynamicArray<Match>& outMatches);
 
 
+// Scores every resume once and from then on keeps s.topMatches equal to
+// topKJobsForResume(): a new job is scored only against resumes sharing a
+// word with it whose K-th score it can still beat, a new resume only
+// against the jobs sharing a word with it. K == 0 drops the table.
+void buildMatches(Store& s, std::size_t K);
+
+
 std::size_t approxBytes(const Store& s);
 bool save(const Store& s);
 
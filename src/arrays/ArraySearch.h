@@ -1,8 +1,10 @@
 #pragma once
 #include <string>
+#include "utils/CiPattern.h"
 
 
 namespace arrayalgo {
-// Case‑insensitive substring search using KMP
+// Case‑insensitive substring search. Folds the pattern on every call; loops
+// over many rows should build one CiPattern and call foundIn() instead.
 bool containsKeywordCI(const std::string& text, const std::string& pattern);
 }
\ No newline at end of file
@@ -59,4 +59,10 @@ return jaccard_from_sets(A,B);
 }
 
 
+void splitUniqueIds(const std::string& s, TokenIds& out){ tokens::wordIds(s, out); }
+
+
+double jaccard(const TokenIds& A, const TokenIds& B){ return tokens::jaccard(A,B); }
+
+
 } // namespace arrayalgo
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 #include <string>
 #include "arrays/DynamicArray.h"
+#include "utils/TokenDictionary.h"
 
 
 namespace arrayalgo {
 void splitUniqueSorted(const std::string& s, DynamicArray<std::string>& out);
 double jaccard(const DynamicArray<std::string>& A,
 const DynamicArray<std::string>& B);
+// Same token rules as splitUniqueSorted, interned to sorted ids
+void splitUniqueIds(const std::string& s, TokenIds& out);
+double jaccard(const TokenIds& A, const TokenIds& B);
 }
\ No newline at end of file
@@ -1,149 +1,264 @@
 #include "ResumeArray.h"
+#include "io/MappedFile.h"
+#include "utils/KeySort.h"
 #include <iostream>
-#include <fstream>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace array2 {
 
-    ResumeArray::ResumeArray() = default;
+    // Big-endian first 8 bytes (zero padded): comparing two keys as integers
+    // orders names like std::string does, except that equal keys need a full
+    // compare.
+    static std::uint64_t prefixKey(const std::string& s) {
+        std::uint64_t k = 0;
+        for (size_t i = 0; i < 8; ++i)
+            k = (k << 8) | (i < s.size() ? static_cast<unsigned char>(s[i]) : 0u);
+        return k;
+    }
+
+    ResumeArray::ResumeArray() {
+        clear();
+    }
+
+    void ResumeArray::clear() {
+        ids_.clear();
+        nameOff_.assign(1, 0);
+        skillsOff_.assign(1, 0);
+        nameKey_.clear();
+        names_.clear();
+        skills_.clear();
+        order_.clear();
+        pos_.clear();
+        index_.clear();
+        idIndex_.clear();
+        byName_.clear();
+    }
 
     void ResumeArray::insert(const Resume& r) {
-        if (count_ < kMax) {
-            data_[count_] = r;
-            ++count_;
-        }
+        const Row row = static_cast<Row>(ids_.size());
+        ids_.push_back(r.id);
+        names_ += r.name;
+        nameOff_.push_back(names_.size());
+        skills_ += r.skills;
+        skillsOff_.push_back(skills_.size());
+        nameKey_.push_back(prefixKey(r.name));
+
+        // new rows go to the end of the current order
+        pos_.push_back(static_cast<int>(order_.size()));
+        order_.push_back(row);
+
+        index_.add(row, r.skills);
+        idIndex_.insert(r.id, static_cast<IdIndex::Slot>(row));
+        byName_.add(row);
+    }
+
+    // ---------------- row access ----------------
+    TextView ResumeArray::nameOf(Row r) const {
+        TextView v;
+        v.data = names_.data() + nameOff_[r];
+        v.size = nameOff_[r + 1] - nameOff_[r];
+        return v;
+    }
+
+    TextView ResumeArray::skillsOf(Row r) const {
+        TextView v;
+        v.data = skills_.data() + skillsOff_[r];
+        v.size = skillsOff_[r + 1] - skillsOff_[r];
+        return v;
+    }
+
+    ResumeRef ResumeArray::rowRef(Row r) const {
+        ResumeRef ref;
+        ref.id = ids_[r];
+        ref.name = nameOf(r);
+        ref.skills = skillsOf(r);
+        return ref;
+    }
+
+    size_t ResumeArray::memoryBytes() const {
+        return ids_.size() * sizeof(int)
+            + (nameOff_.size() + skillsOff_.size()) * sizeof(size_t)
+            + nameKey_.size() * sizeof(std::uint64_t)
+            + order_.size() * sizeof(Row) + pos_.size() * sizeof(int)
+            + names_.size() + skills_.size();
     }
 
     // ---------------- CSV load ----------------
     bool ResumeArray::loadFromCsv(const std::string& path, int* outLoaded) {
-        std::ifstream f(path);
-        if (!f.is_open()) {
+        MappedFile file;
+        if (!file.open(path)) {
             std::cerr << "[Array2] ERROR: cannot open " << path << "\n";
             if (outLoaded) *outLoaded = 0;
             return false;
         }
 
-        std::string line;
+        CsvScanner scan(file.data(), file.size());
+        TextView line;
         // skip header
-        if (!std::getline(f, line)) {
+        if (!scan.nextLine(line)) {
             if (outLoaded) *outLoaded = 0;
             return false;
         }
 
         int loaded = 0;
-        while (std::getline(f, line) && count_ < kMax) {
+        Resume r;
+        while (scan.nextLine(line)) {
             if (line.empty()) continue;
 
-            Resume r;
-            r.id = count_ + 1;                            // synthetic id
+            r.id = size() + 1;                            // synthetic id
             r.name = "Candidate_" + std::to_string(r.id);
-            r.skills = line;                                  // keep whole line as text
+            r.skills.assign(line.data, line.size);        // keep whole line as text
 
             insert(r);
             ++loaded;
         }
 
+        byName_.settle([this](Row row) { return nameOf(row); });
         if (outLoaded) *outLoaded = loaded;
         return true;
     }
 
     // ---------------- searching ----------------
-    const Resume* ResumeArray::searchById(int id) const {
-        if (id <= 0 || id > count_) return nullptr;
-        for (int i = 0; i < count_; ++i)
-            if (data_[i].id == id) return &data_[i];
-        return nullptr;
+    bool ResumeArray::searchById(int id, ResumeRef& out) const {
+        IdIndex::Slot row;
+        if (!idIndex_.find(id, row)) return false;
+        out = rowRef(row);
+        return true;
     }
 
     int ResumeArray::filterBySkill(const std::string& skill,
         std::vector<int>& outIndexes,
         int maxToCollect) const {
         outIndexes.clear();
+
+        // the index folds case, so candidates are re-checked with the
+        // original case-sensitive search
+        InvertedIndex::Postings rows;
+        index_.candidates(skill, rows);
+
         int hits = 0;
-        for (int i = 0; i < count_; ++i) {
-            if (data_[i].skills.find(skill) != std::string::npos) {
+        for (InvertedIndex::Row row : rows) {
+            const TextView text = skillsOf(row);
+            if (std::search(text.data, text.data + text.size, skill.begin(), skill.end())
+                != text.data + text.size || skill.empty()) {
                 ++hits;
-                if ((int)outIndexes.size() < maxToCollect)
-                    outIndexes.push_back(i);
+                outIndexes.push_back(pos_[row]);
             }
         }
+
+        // rows are ascending, positions follow the current order
+        if ((int)outIndexes.size() > maxToCollect) {
+            const int keep = std::max(0, maxToCollect);
+            std::nth_element(outIndexes.begin(), outIndexes.begin() + keep, outIndexes.end());
+            outIndexes.resize(keep);
+        }
+        std::sort(outIndexes.begin(), outIndexes.end());
         return hits;
     }
 
     // ---------------- display ----------------
-    static std::string preview(const std::string& s, std::size_t n = 80) {
-        if (s.size() <= n) return s;
-        return s.substr(0, n) + "...";
+    static std::string preview(const TextView& s, std::size_t n = 80) {
+        if (s.size <= n) return s.str();
+        return std::string(s.data, n) + "...";
     }
 
     void ResumeArray::displayTop(std::ostream& os, int top) const {
-        const int limit = std::min(top, count_);
-        for (int i = 0; i < limit; ++i) {
-            os << "[" << data_[i].id << "] "
-                << "Name=\"" << data_[i].name << "\"  "
-                << "Text=\"" << preview(data_[i].skills, 90) << "\"\n";
-        }
+        page(0, top, [&os](const ResumeRef& r) {
+            os << "[" << r.id << "] "
+                << "Name=\"" << r.name.str() << "\"  "
+                << "Text=\"" << preview(r.skills, 90) << "\"\n";
+        });
     }
 
     // ---------------- sorting by name ----------------
+    bool ResumeArray::nameLess(Row a, Row b) const {
+        if (nameKey_[a] != nameKey_[b]) return nameKey_[a] < nameKey_[b];
+        const TextView x = nameOf(a), y = nameOf(b);
+        const int c = std::memcmp(x.data, y.data, std::min(x.size, y.size));
+        return c < 0 || (c == 0 && x.size < y.size);
+    }
+
+    void ResumeArray::syncPositions() {
+        for (size_t i = 0; i < order_.size(); ++i)
+            pos_[order_[i]] = static_cast<int>(i);
+    }
+
     void ResumeArray::bubbleSortByName() {
         auto t0 = std::chrono::high_resolution_clock::now();
+        const int n = size();
 
         int swaps = 0;
-        for (int i = 0; i < count_ - 1; ++i) {
+        for (int i = 0; i < n - 1; ++i) {
             bool changed = false;
-            for (int j = 0; j < count_ - i - 1; ++j) {
-                if (data_[j].name > data_[j + 1].name) {
-                    std::swap(data_[j], data_[j + 1]);
+            for (int j = 0; j < n - i - 1; ++j) {
+                if (nameLess(order_[j + 1], order_[j])) {
+                    std::swap(order_[j], order_[j + 1]);
                     changed = true;
                     ++swaps;
                 }
             }
             if (!changed) break;
         }
+        syncPositions();
 
         auto t1 = std::chrono::high_resolution_clock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
         std::cout << "[Array2] BubbleSort(name) time: " << ms
             << " ms, swaps: " << swaps
-            << "  | memory ~" << (count_ * sizeof(Resume)) / 1024 << " KB\n";
+            << "  | memory ~" << memoryBytes() / 1024 << " KB\n";
     }
 
+    // Hoare partition around the middle row: equal names stop both scans,
+    // so runs of equal keys split evenly instead of going quadratic.
     int ResumeArray::partitionByName(int lo, int hi) {
-        int mid = lo + (hi - lo) / 2;
-        std::swap(data_[mid], data_[hi]);
-        const std::string& pivot = data_[hi].name;
-        int i = lo - 1;
-        for (int j = lo; j < hi; ++j) {
-            if (data_[j].name <= pivot) {
-                ++i;
-                std::swap(data_[i], data_[j]);
-            }
+        const Row pivot = order_[lo + (hi - lo) / 2];
+        int i = lo - 1, j = hi + 1;
+        for (;;) {
+            do { ++i; } while (nameLess(order_[i], pivot));
+            do { --j; } while (nameLess(pivot, order_[j]));
+            if (i >= j) return j;
+            std::swap(order_[i], order_[j]);
         }
-        std::swap(data_[i + 1], data_[hi]);
-        return i + 1;
     }
 
+    // recurses into the smaller half and loops on the larger one
     void ResumeArray::qsortByName(int lo, int hi) {
-        if (lo < hi) {
-            int p = partitionByName(lo, hi);
-            qsortByName(lo, p - 1);
-            qsortByName(p + 1, hi);
+        while (lo < hi) {
+            const int p = partitionByName(lo, hi);
+            if (p - lo < hi - p) { qsortByName(lo, p); lo = p + 1; }
+            else { qsortByName(p + 1, hi); hi = p; }
         }
     }
 
     void ResumeArray::quickSortByName() {
-        if (count_ <= 1) return;
+        const int n = size();
+        if (n <= 1) return;
         auto t0 = std::chrono::high_resolution_clock::now();
-        qsortByName(0, count_ - 1);
+        qsortByName(0, n - 1);
+        syncPositions();
         auto t1 = std::chrono::high_resolution_clock::now();
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-        int approxDepth = (int)std::max(1.0, std::log2(std::max(1, count_)));
+        int approxDepth = (int)std::max(1.0, std::log2(std::max(1, n)));
         std::cout << "[Array2] QuickSort(name) time: " << ms
-            << " ms  | memory ~" << (count_ * sizeof(Resume)) / 1024
+            << " ms  | memory ~" << memoryBytes() / 1024
             << " KB  | stack~" << approxDepth << " levels\n";
     }
 
+    void ResumeArray::sortByName(unsigned threads) {
+        if (size() <= 1) return;
+        std::vector<TextView> keys(ids_.size());
+        for (Row r = 0; r < keys.size(); ++r) keys[r] = nameOf(r);
+        keysort::order(keys, false, threads, order_);
+        syncPositions();
+    }
+
+    void ResumeArray::orderByName() {
+        byName_.settle([this](Row row) { return nameOf(row); });
+        order_ = byName_.ordered();
+        syncPositions();
+    }
+
 } // namespace array2
@@ -1,7 +1,13 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <ostream>
+#include "io/CsvScanner.h"
+#include "utils/IdIndex.h"
+#include "utils/InvertedIndex.h"
+#include "utils/SortedIndex.h"
 
 namespace array2 {
 
@@ -11,21 +17,50 @@ namespace array2 {
         std::string skills;   // we reuse this as the single-column text in your CSV
     };
 
+    // Read-only view of one stored resume; the text points into the array's
+    // arenas and stays valid until the next insert or clear.
+    struct ResumeRef {
+        int      id{};
+        TextView name;
+        TextView skills;
+    };
+
+    // Columnar resume store. Each inserted resume gets a fixed row: its id
+    // sits in an id column and its name/skills bytes are appended to two
+    // shared arenas addressed by offset columns. Display order is a separate
+    // permutation of rows, so the sorts shuffle ints instead of strings and
+    // the row-keyed indexes never go stale. Grows without a fixed capacity.
     class ResumeArray {
     public:
-        // Keep this reasonable to avoid huge memory use
-        static const int kMax = 20000;
+        using Row = std::uint32_t;
 
         ResumeArray();
 
         void insert(const Resume& r);
+        void clear();
+        int  size() const { return static_cast<int>(ids_.size()); }
 
         // load single-column CSV (first row = header); returns true/false and count via outLoaded
         bool loadFromCsv(const std::string& path, int* outLoaded);
 
-        const Resume* searchById(int id) const;
+        // Resume at display position `pos` (0 <= pos < size()).
+        ResumeRef at(int pos) const { return rowRef(order_[pos]); }
+
+        // Calls fn(ResumeRef) on up to n resumes from display position `from`
+        // and returns the position after the last one, to resume the next
+        // page from. Positions index order_ directly, so any page is O(n).
+        template<typename Fn>
+        int page(int from, int n, Fn fn) const {
+            const int end = std::min(size(), from + std::max(0, n));
+            for (int pos = std::max(0, from); pos < end; ++pos) fn(at(pos));
+            return std::max(from, end);
+        }
+
+        // false when no resume has this id
+        bool searchById(int id, ResumeRef& out) const;
 
-        // collect up to maxToCollect matching indexes; return total hits
+        // collect up to maxToCollect matching display positions (ascending);
+        // return total hits
         int filterBySkill(const std::string& skill,
             std::vector<int>& outIndexes,
             int maxToCollect) const;
@@ -35,13 +70,40 @@ namespace array2 {
         // Sorting by name
         void bubbleSortByName();
         void quickSortByName();
+        // parallel key sort (utils/KeySort); threads: 0 = all cores
+        void sortByName(unsigned threads = 0);
+        // display order from the maintained name index; no sorting once
+        // the index is settled (loadFromCsv settles it)
+        void orderByName();
+
+        // Column and arena bytes, for the sort reports.
+        size_t memoryBytes() const;
 
     private:
-        int partitionByName(int lo, int hi);
+        ResumeRef rowRef(Row r) const;
+        TextView  nameOf(Row r) const;
+        TextView  skillsOf(Row r) const;
+
+        bool nameLess(Row a, Row b) const;
+        int  partitionByName(int lo, int hi);
         void qsortByName(int lo, int hi);
+        void syncPositions();
+
+        // per row
+        std::vector<int>           ids_;
+        std::vector<size_t>        nameOff_;     // size() + 1 offsets into names_
+        std::vector<size_t>        skillsOff_;   // size() + 1 offsets into skills_
+        std::vector<std::uint64_t> nameKey_;     // first 8 name bytes, big-endian
+        std::string                names_;
+        std::string                skills_;
+
+        // display order: order_[pos] = row, pos_[row] = pos
+        std::vector<Row> order_;
+        std::vector<int> pos_;
 
-        Resume data_[kMax];
-        int    count_{ 0 };
+        InvertedIndex index_;   // skills tokens -> row
+        IdIndex       idIndex_; // id -> row
+        SortedIndex   byName_;  // rows in name order
     };
 
 } // namespace array2
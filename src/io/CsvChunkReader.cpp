@@ -0,0 +1,86 @@
+#include "io/CsvChunkReader.h"
+#include <cstring>
+
+namespace {
+
+    // End of the record starting at p (past its '\n'), or nullptr when the
+    // record runs past `end`. Same record shape as CsvScanner::skipRecord.
+    const char* recordEnd(const char* p, const char* end) {
+        if (*p == '"') {
+            const char* q = csvscan::findByte(p + 1, end, '"');
+            while (q + 1 < end && q[1] == '"') q = csvscan::findByte(q + 2, end, '"');
+            // no closing quote yet, or one that may be the first half of ""
+            if (q + 1 >= end) return nullptr;
+            p = q + 1;
+        }
+        const char* nl = csvscan::findByte(p, end, '\n');
+        return nl < end ? nl + 1 : nullptr;
+    }
+
+} // namespace
+
+CsvChunkReader::CsvChunkReader(size_t windowBytes)
+    : buf(windowBytes < 4096 ? 4096 : windowBytes) {}
+
+bool CsvChunkReader::open(const std::string& path) {
+    in.open(path, std::ios::binary);
+    head = tail = 0;
+    eof = false;
+    if (!in.is_open()) return false;
+
+    // header: everything up to the first newline
+    for (;;) {
+        const char* b = buf.data() + head;
+        const char* e = buf.data() + tail;
+        const char* nl = csvscan::findByte(b, e, '\n');
+        if (nl < e) { head = (size_t)(nl + 1 - buf.data()); return true; }
+        head = tail;
+        if (!fill()) return true;
+    }
+}
+
+bool CsvChunkReader::fill() {
+    if (eof) return false;
+
+    // carry the unread tail to the front; grow only if it fills the window
+    const size_t carry = tail - head;
+    if (carry && head) std::memmove(buf.data(), buf.data() + head, carry);
+    head = 0;
+    tail = carry;
+    if (tail == buf.size()) buf.resize(buf.size() * 2);
+
+    in.read(buf.data() + tail, (std::streamsize)(buf.size() - tail));
+    const size_t got = (size_t)in.gcount();
+    tail += got;
+    if (got == 0) eof = true;
+    return got > 0;
+}
+
+bool CsvChunkReader::next(TextView& block) {
+    for (;;) {
+        const char* b = buf.data() + head;
+        const char* e = buf.data() + tail;
+
+        const char* cut = b;
+        for (const char* r = b; r < e; ) {
+            const char* re = recordEnd(r, e);
+            if (!re) break;
+            cut = r = re;
+        }
+        if (cut > b) {
+            block.data = b;
+            block.size = (size_t)(cut - b);
+            head = (size_t)(cut - buf.data());
+            return true;
+        }
+
+        if (!fill()) {
+            // end of file: whatever is left is the last record
+            if (head == tail) return false;
+            block.data = buf.data() + head;
+            block.size = tail - head;
+            head = tail;
+            return true;
+        }
+    }
+}
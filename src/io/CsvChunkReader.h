@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "io/CsvScanner.h"
+
+// Reads a single-column CSV front to back through a fixed-size window, for
+// files too large to load or map at once. Each next() hands out the whole
+// records currently in the window as one block of raw bytes (walk it with
+// CsvScanner, fileStart = false); a record cut by the window edge is carried
+// into the next block. The window only grows when one record is larger
+// than it.
+class CsvChunkReader {
+public:
+    explicit CsvChunkReader(size_t windowBytes = 4u << 20);
+
+    // Opens the file and skips the header line; false if it cannot be opened.
+    bool open(const std::string& path);
+
+    // Next block of whole records, valid until the following call; false at
+    // the end of the file.
+    bool next(TextView& block);
+
+    size_t windowBytes() const { return buf.size(); }
+
+private:
+    bool fill();   // false once the file has nothing more to give
+
+    std::ifstream     in;
+    std::vector<char> buf;
+    size_t head = 0;   // first unread byte in buf
+    size_t tail = 0;   // end of the bytes read into buf
+    bool   eof = false;
+};
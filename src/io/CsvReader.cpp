@@ -1,11 +1,17 @@
 ﻿#include "io/CsvReader.h"
+#include "io/CsvChunkReader.h"
+#include "io/CsvScanner.h"
+#include "io/MappedFile.h"
+#include "utils/SkillBits.h"
+#include "utils/ThreadPool.h"
+#include "utils/TokenDictionary.h"
 
-#include <fstream>
-#include <sstream>
-#include <string>
 #include <algorithm>
+#include <string>
 #include <cctype>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 
 // ===== counters definition =====
 int CsvReader::lastSkippedResumes = 0;
@@ -13,96 +19,191 @@ int CsvReader::lastSkippedJobs = 0;
 
 namespace {
 
-    static inline void stripBOM(std::string& s) {
-        if (s.size() >= 3 &&
-            (unsigned char)s[0] == 0xEF &&
-            (unsigned char)s[1] == 0xBB &&
-            (unsigned char)s[2] == 0xBF) {
-            s.erase(0, 3);
-        }
+    static inline bool isSpace(char c) {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
     }
 
-    static std::string makeTitleFromSentence(const std::string& s) {
-        std::istringstream iss(s);
-        std::string words[6];
+    // Drops trailing CR/LF left inside a quoted field.
+    static inline void trimEol(TextView& v) {
+        while (v.size && (v.data[v.size - 1] == '\r' || v.data[v.size - 1] == '\n')) --v.size;
+    }
+
+    // First six whitespace-separated words, joined by single spaces.
+    static std::string makeTitleFromSentence(const TextView& s) {
+        std::string out;
         int count = 0;
-        std::string w;
-        while (iss >> w) {
-            if (count < 6) {
-                words[count++] = w;
-            }
-            else break;
+        size_t i = 0;
+        while (i < s.size && count < 6) {
+            while (i < s.size && isSpace(s.data[i])) ++i;
+            if (i == s.size) break;
+            size_t b = i;
+            while (i < s.size && !isSpace(s.data[i])) ++i;
+            if (count++) out.push_back(' ');
+            out.append(s.data + b, i - b);
         }
         if (count == 0) return "Untitled";
-        std::ostringstream out;
-        for (int i = 0; i < count; ++i) {
-            if (i) out << ' ';
-            out << words[i];
+        return out;
+    }
+
+    static std::string extractSkillsFromSentence(const TextView& s) {
+        return skills::toList(skills::extract(s.data, s.size));
+    }
+
+    // One record -> resume skills; false if blank.
+    static bool parseResumeSkills(TextView text, ResumeLinkedList::Resume& r) {
+        trimEol(text);
+        if (text.empty()) return false;
+        r.skills = extractSkillsFromSentence(text);
+        if (r.skills.empty()) r.skills = text.str();
+        return true;
+    }
+
+    // Skill phrases of one parsed chunk, numbered by first use in the chunk.
+    // Chunks are parsed on the pool, so interning there would number the
+    // phrases in thread timing order; instead each chunk keeps local ids and
+    // they are mapped to dictionary ids while the chunks are joined in file
+    // order, which numbers every phrase exactly as a serial load does.
+    struct ChunkPhrases {
+        std::unordered_map<std::string, TokenId> ids;
+        std::vector<std::string> texts;   // by local id
+        std::vector<TokenId> global;      // local id -> dictionary id
+        std::vector<std::string> parts;   // scratch
+
+        // tokens::skillIds with local ids (unique, not yet sorted).
+        void skillIds(const std::string& raw, TokenIds& out) {
+            parts.clear();
+            tokens::skillPhrases(raw, parts);
+            out.clear();
+            for (const std::string& p : parts) {
+                auto ins = ids.emplace(p, (TokenId)texts.size());
+                if (ins.second) texts.push_back(p);
+                out.push_back(ins.first->second);
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+
+        // Interns the chunk's phrases in first-use order; call per chunk in
+        // file order, then toGlobal() on each of its rows.
+        void internAll() {
+            TokenDictionary& dict = TokenDictionary::global();
+            global.resize(texts.size());
+            for (size_t i = 0; i < texts.size(); ++i) global[i] = dict.intern(texts[i]);
+        }
+
+        void toGlobal(TokenIds& row) const {
+            for (TokenId& id : row) id = global[id];
+            std::sort(row.begin(), row.end());
         }
-        return out.str();
-    }
-
-    static std::string extractSkillsFromSentence(const std::string& s) {
-        static const char* keys[] = {
-            "python","java","sql","excel","power bi","tableau","reporting",
-            "machine learning","deep learning","nlp","pandas","statistics",
-            "git","docker","spring boot","rest apis","system design","agile",
-            "computer vision","tensorflow","keras","pytorch","mlops","cloud",
-            "scrum","stakeholder management","product roadmap","user stories"
-        };
-        std::string lower = s;
-        std::transform(lower.begin(), lower.end(), lower.begin(),
-            [](unsigned char c) { return (char)std::tolower(c); });
-
-        std::ostringstream out;
-        bool first = true;
-        for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
-            const char* k = keys[i];
-            if (lower.find(k) != std::string::npos) {
-                if (!first) out << '|';
-                out << k;
-                first = false;
+    };
+
+    // One record -> a prepared resume (skills + features); false if blank.
+    static bool parseResume(TextView text, ResumeLinkedList::Resume& r) {
+        if (!parseResumeSkills(text, r)) return false;
+        ResumeLinkedList::computeFeatures(r);
+        return true;
+    }
+
+    // parseResume for the pool: computeFeatures with chunk-local phrase ids.
+    static bool parseResumeChunk(TextView text, ResumeLinkedList::Resume& r, ChunkPhrases& phrases) {
+        if (!parseResumeSkills(text, r)) return false;
+        phrases.skillIds(r.skills, r.skillIds);
+        r.skillBits = skills::fromList(r.skills);
+        return true;
+    }
+
+    // Streamed resumes are scored and dropped: only phrase ids the dictionary
+    // already knows, so it does not grow with the stream (and no lookup
+    // changes it, so the ids are final on the pool).
+    static bool parseStreamedResume(TextView text, ResumeLinkedList::Resume& r, ChunkPhrases&) {
+        if (!parseResumeSkills(text, r)) return false;
+        tokens::knownSkillIds(r.skills, r.skillIds);
+        return true;
+    }
+
+    // One record -> job title and required skills; false if blank.
+    static bool parseJobText(TextView desc, JobLinkedList::Job& j) {
+        trimEol(desc);
+        if (desc.empty()) return false;
+        j.title = makeTitleFromSentence(desc);
+        j.required = extractSkillsFromSentence(desc);
+        if (j.required.empty()) j.required = desc.str();
+        return true;
+    }
+
+    // One record -> a prepared job (title, required + features); false if blank.
+    static bool parseJob(TextView desc, JobLinkedList::Job& j) {
+        if (!parseJobText(desc, j)) return false;
+        JobLinkedList::computeFeatures(j);
+        return true;
+    }
+
+    // parseJob for the pool, with chunk-local phrase ids.
+    static bool parseJobChunk(TextView desc, JobLinkedList::Job& j, ChunkPhrases& phrases) {
+        if (!parseJobText(desc, j)) return false;
+        phrases.skillIds(j.required, j.skillIds);
+        j.skillBits = skills::fromList(j.required);
+        return true;
+    }
+
+    // The bytes after the header line (empty when there is no header).
+    static TextView recordsOf(const MappedFile& file) {
+        CsvScanner scan(file.data(), file.size());
+        TextView header;
+        if (!scan.nextLine(header)) return TextView{};
+        return TextView{ scan.position(), (size_t)(file.data() + file.size() - scan.position()) };
+    }
+
+    // Cuts a block of whole records into ~equal byte ranges. Boundaries come
+    // from a skip-only pass of the same scanner, so quoted fields that span
+    // lines are never split.
+    static void splitRecords(const TextView& records, size_t parts,
+        std::vector<TextView>& ranges) {
+        ranges.clear();
+        if (records.empty()) return;
+        CsvScanner scan(records.data, records.size, false);
+
+        const char* start = records.data;
+        const char* end = records.data + records.size;
+        if (parts == 0) parts = 1;
+        const size_t step = (size_t)(end - start) / parts + 1;
+
+        const char* target = start + step;
+        while (scan.skipRecord()) {
+            if (scan.position() >= target || scan.position() >= end) {
+                ranges.push_back(TextView{ start, (size_t)(scan.position() - start) });
+                start = scan.position();
+                target = start + step;
             }
         }
-        return out.str();
-    }
-
-    static bool getlineCSV(std::istream& in, std::string& out) {
-        out.clear();
-        int c = in.peek();
-        if (c == EOF) return false;
-
-        if (c == '"') {
-            in.get();
-            bool inQuote = true;
-            while (in.good()) {
-                char ch = (char)in.get();
-                if (!in.good()) break;
-                if (inQuote) {
-                    if (ch == '"') {
-                        int nxt = in.peek();
-                        if (nxt == '"') {
-                            out.push_back('"');
-                            in.get();
-                        }
-                        else {
-                            inQuote = false;
-                        }
-                    }
-                    else {
-                        out.push_back(ch);
-                    }
-                }
-                else {
-                    if (ch == '\n') break;
+        if (start < end) ranges.push_back(TextView{ start, (size_t)(end - start) });
+    }
+
+    // Parses every range on the pool; chunk k keeps the rows of range k in
+    // file order, so concatenating chunks reproduces the serial order.
+    // phrases[k] holds the local phrase ids of chunk k (see ChunkPhrases).
+    template<typename Row, typename Parse>
+    static void parseChunked(const TextView& records, ThreadPool& pool, Parse parse,
+        std::vector<std::vector<Row>>& chunks, std::vector<ChunkPhrases>& phrases, int& skipped) {
+        std::vector<TextView> ranges;
+        splitRecords(records, (size_t)pool.size() * 4, ranges);
+
+        chunks.assign(ranges.size(), std::vector<Row>());
+        phrases.assign(ranges.size(), ChunkPhrases());
+        std::vector<int> skippedPer(ranges.size(), 0);
+        pool.parallelFor(ranges.size(), 1, [&](size_t b, size_t e) {
+            for (size_t k = b; k < e; ++k) {
+                CsvScanner scan(ranges[k].data, ranges[k].size, false);
+                TextView rec;
+                while (scan.nextRecord(rec)) {
+                    Row row{};
+                    if (parse(rec, row, phrases[k])) chunks[k].push_back(std::move(row));
+                    else ++skippedPer[k];
                 }
             }
-            return true;
-        }
-        else {
-            std::getline(in, out);
-            return !out.empty() || in.good();
-        }
+            });
+        skipped = 0;
+        for (int n : skippedPer) skipped += n;
     }
 
 } 
@@ -110,35 +211,28 @@ namespace {
 bool CsvReader::loadResumes(const std::string& path, ResumeLinkedList& out) {
     lastSkippedResumes = 0;
 
-    std::ifstream f(path);
-    if (!f.is_open()) {
+    MappedFile file;
+    if (!file.open(path)) {
         std::cerr << "[CsvReader] cannot open: " << path << "\n";
         return false;
     }
 
     out.clear();
 
-    std::string line;
-    if (!std::getline(f, line)) return false;
-    stripBOM(line);
+    CsvScanner scan(file.data(), file.size());
+    TextView text;
+    if (!scan.nextLine(text)) return false;   // header
 
     int id = 1;
     int loaded = 0;
 
-    while (true) {
-        std::string text;
-        if (!getlineCSV(f, text)) break;
+    while (scan.nextRecord(text)) {
+        ResumeLinkedList::Resume r{};
+        if (!parseResume(text, r)) { ++lastSkippedResumes; continue; }
 
-        while (!text.empty() && (text.back() == '\r' || text.back() == '\n')) text.pop_back();
-
-        if (text.empty()) { ++lastSkippedResumes; continue; }
-
-        std::string name = "Candidate " + std::to_string(id);
-        std::string degree = "";
-        std::string skills = extractSkillsFromSentence(text);
-        if (skills.empty()) skills = text;
-
-        out.insertResume(id, name, skills, degree);
+        r.id = id;
+        r.name = "Candidate " + std::to_string(id);
+        out.insertResume(std::move(r));
         ++id;
         ++loaded;
     }
@@ -149,37 +243,127 @@ bool CsvReader::loadResumes(const std::string& path, ResumeLinkedList& out) {
 bool CsvReader::loadJobs(const std::string& path, JobLinkedList& out) {
     lastSkippedJobs = 0;
 
-    std::ifstream f(path);
-    if (!f.is_open()) {
+    MappedFile file;
+    if (!file.open(path)) {
         std::cerr << "[CsvReader] cannot open: " << path << "\n";
         return false;
     }
 
     out.clear();
 
-    std::string line;
-    if (!std::getline(f, line)) return false;
-    stripBOM(line);
+    CsvScanner scan(file.data(), file.size());
+    TextView desc;
+    if (!scan.nextLine(desc)) return false;   // header
 
     int id = 1;
     int loaded = 0;
 
-    while (true) {
-        std::string desc;
-        if (!getlineCSV(f, desc)) break;
-
-        while (!desc.empty() && (desc.back() == '\r' || desc.back() == '\n')) desc.pop_back();
-
-        if (desc.empty()) { ++lastSkippedJobs; continue; }
+    while (scan.nextRecord(desc)) {
+        JobLinkedList::Job j{};
+        if (!parseJob(desc, j)) { ++lastSkippedJobs; continue; }
 
-        std::string title = makeTitleFromSentence(desc);
-        std::string required = extractSkillsFromSentence(desc);
-        if (required.empty()) required = desc;
-
-        out.insertJob(id, title, required);
+        j.id = id;
+        out.insertJob(std::move(j));
         ++id;
         ++loaded;
     }
 
     return loaded > 0;
 }
+
+bool CsvReader::loadResumesParallel(const std::string& path, ResumeLinkedList& out,
+    unsigned threads) {
+    lastSkippedResumes = 0;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "[CsvReader] cannot open: " << path << "\n";
+        return false;
+    }
+
+    out.clear();
+    if (file.size() == 0) return false;
+
+    ThreadPool pool(threads);
+    std::vector<std::vector<ResumeLinkedList::Resume>> chunks;
+    std::vector<ChunkPhrases> phrases;
+    parseChunked(recordsOf(file), pool, parseResumeChunk, chunks, phrases, lastSkippedResumes);
+
+    int id = 1;
+    for (size_t k = 0; k < chunks.size(); ++k) {
+        phrases[k].internAll();
+        for (auto& r : chunks[k]) {
+            phrases[k].toGlobal(r.skillIds);
+            r.id = id;
+            r.name = "Candidate " + std::to_string(id);
+            out.insertResume(std::move(r));
+            ++id;
+        }
+    }
+    return id > 1;
+}
+
+bool CsvReader::loadJobsParallel(const std::string& path, JobLinkedList& out,
+    unsigned threads) {
+    lastSkippedJobs = 0;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "[CsvReader] cannot open: " << path << "\n";
+        return false;
+    }
+
+    out.clear();
+    if (file.size() == 0) return false;
+
+    ThreadPool pool(threads);
+    std::vector<std::vector<JobLinkedList::Job>> chunks;
+    std::vector<ChunkPhrases> phrases;
+    parseChunked(recordsOf(file), pool, parseJobChunk, chunks, phrases, lastSkippedJobs);
+
+    int id = 1;
+    for (size_t k = 0; k < chunks.size(); ++k) {
+        phrases[k].internAll();
+        for (auto& j : chunks[k]) {
+            phrases[k].toGlobal(j.skillIds);
+            j.id = id;
+            out.insertJob(std::move(j));
+            ++id;
+        }
+    }
+    return id > 1;
+}
+
+bool CsvReader::streamResumes(const std::string& path, ThreadPool& pool, size_t windowBytes,
+    const std::function<void(std::vector<ResumeLinkedList::Resume>&)>& sink) {
+    lastSkippedResumes = 0;
+
+    CsvChunkReader reader(windowBytes);
+    if (!reader.open(path)) {
+        std::cerr << "[CsvReader] cannot open: " << path << "\n";
+        return false;
+    }
+
+    std::vector<std::vector<ResumeLinkedList::Resume>> chunks;
+    std::vector<ChunkPhrases> unused;   // streamed ids are dictionary ids already
+    std::vector<ResumeLinkedList::Resume> batch;
+    TextView block;
+    int id = 1;
+    while (reader.next(block)) {
+        int skipped = 0;
+        parseChunked(block, pool, parseStreamedResume, chunks, unused, skipped);
+        lastSkippedResumes += skipped;
+
+        batch.clear();
+        for (auto& chunk : chunks) {
+            for (auto& r : chunk) {
+                r.id = id;
+                r.name = "Candidate " + std::to_string(id);
+                batch.push_back(std::move(r));
+                ++id;
+            }
+        }
+        if (!batch.empty()) sink(batch);
+    }
+    return id > 1;
+}
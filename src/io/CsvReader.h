@@ -1,7 +1,11 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <vector>
 #include "models/ResumeLinkedList.h"
 #include "models/JobLinkedList.h"
+#include "utils/ThreadPool.h"
 
 namespace CsvReader {
 
@@ -14,4 +18,21 @@ namespace CsvReader {
     bool loadResumes(const std::string& path, ResumeLinkedList& out);
     bool loadJobs(const std::string& path, JobLinkedList& out);
 
+    // Same result (rows, ids, counters) as the serial loaders, but records are
+    // split into byte ranges on record boundaries and parsed on a thread pool
+    // (threads = 0 -> all cores); chunks are appended in file order.
+    bool loadResumesParallel(const std::string& path, ResumeLinkedList& out,
+        unsigned threads = 0);
+    bool loadJobsParallel(const std::string& path, JobLinkedList& out,
+        unsigned threads = 0);
+
+    // Reads a resume CSV without loading it: the file goes through a window
+    // of `windowBytes` (io/CsvChunkReader), the whole records in it are parsed
+    // on `pool`, and `sink` gets them as one batch in file order, with the ids
+    // and names loadResumes would give. The batch is reused, so the sink must
+    // not keep pointers into it. Resumes carry skills and the ids of phrases
+    // already in the token dictionary (the job side's), not skillBits.
+    bool streamResumes(const std::string& path, ThreadPool& pool, size_t windowBytes,
+        const std::function<void(std::vector<ResumeLinkedList::Resume>&)>& sink);
+
 } // namespace CsvReader
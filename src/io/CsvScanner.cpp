@@ -0,0 +1,107 @@
+#include "io/CsvScanner.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSVSCAN_SSE2 1
+#endif
+
+// ---- byte finders ----
+namespace csvscan {
+
+#if defined(CSVSCAN_SSE2)
+    static inline unsigned firstBit(unsigned m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long i; _BitScanForward(&i, m); return (unsigned)i;
+#else
+        return (unsigned)__builtin_ctz(m);
+#endif
+    }
+#endif
+
+    const char* findByte(const char* p, const char* end, char c) {
+#if defined(CSVSCAN_SSE2)
+        const __m128i needle = _mm_set1_epi8(c);
+        for (; p + 16 <= end; p += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+            if (m) return p + firstBit(m);
+        }
+#endif
+        const void* hit = std::memchr(p, c, (size_t)(end - p));
+        return hit ? static_cast<const char*>(hit) : end;
+    }
+
+} // namespace csvscan
+
+// ---- scanner ----
+CsvScanner::CsvScanner(const char* data, size_t size, bool fileStart)
+    : begin(fileStart ? data : nullptr), pos(data), end(data + size) {}
+
+bool CsvScanner::nextLine(TextView& out) {
+    if (pos >= end) return false;
+    const char* s = pos;
+    if (s == begin && end - s >= 3 &&
+        (unsigned char)s[0] == 0xEF && (unsigned char)s[1] == 0xBB && (unsigned char)s[2] == 0xBF)
+        s += 3;
+
+    const char* nl = csvscan::findByte(s, end, '\n');
+    pos = (nl < end) ? nl + 1 : end;
+
+    const char* e = nl;
+    if (e > s && e[-1] == '\r') --e;
+    out.data = s;
+    out.size = (size_t)(e - s);
+    return true;
+}
+
+bool CsvScanner::skipRecord() {
+    if (pos >= end) return false;
+    const char* p = pos;
+    if (*p == '"') {
+        const char* q = csvscan::findByte(p + 1, end, '"');
+        while (q + 1 < end && q[1] == '"') q = csvscan::findByte(q + 2, end, '"');
+        if (q >= end) { pos = end; return true; }
+        p = q + 1;
+    }
+    const char* nl = csvscan::findByte(p, end, '\n');
+    pos = (nl < end) ? nl + 1 : end;
+    return true;
+}
+
+bool CsvScanner::nextRecord(TextView& out) {
+    if (pos >= end) return false;
+    if (*pos != '"') return nextLine(out);
+
+    const char* s = pos + 1;
+    const char* q = csvscan::findByte(s, end, '"');
+    bool copied = false;
+
+    // "" inside the field: switch to the scratch copy and keep unescaping
+    while (q + 1 < end && q[1] == '"') {
+        if (!copied) { scratch.assign(s, q + 1); copied = true; }
+        else scratch.append(s, q + 1);
+        s = q + 2;
+        q = csvscan::findByte(s, end, '"');
+    }
+
+    if (copied) {
+        scratch.append(s, q);
+        out.data = scratch.data();
+        out.size = scratch.size();
+    }
+    else {
+        out.data = s;
+        out.size = (size_t)(q - s);
+    }
+
+    // drop whatever follows the closing quote on this line
+    if (q < end) {
+        const char* nl = csvscan::findByte(q + 1, end, '\n');
+        pos = (nl < end) ? nl + 1 : end;
+    }
+    else {
+        pos = end;
+    }
+    return true;
+}
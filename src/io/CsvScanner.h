@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Non-owning view of a record inside a buffer (or inside the scanner's
+// scratch string when the field had to be unescaped).
+struct TextView {
+    const char* data = nullptr;
+    size_t      size = 0;
+
+    bool        empty() const { return size == 0; }
+    std::string str() const { return std::string(data, size); }
+};
+
+namespace csvscan {
+    // SSE2 byte finder; returns `end` when nothing matches.
+    const char* findByte(const char* p, const char* end, char c);
+}
+
+// Walks a single-column CSV held in memory (typically a MappedFile).
+// Records point into the buffer; only a quoted field containing "" is
+// copied (unescaped) into a scratch string owned by the scanner, which stays
+// valid until the next call.
+class CsvScanner {
+public:
+    // fileStart = false for a buffer that starts mid-file (a chunk of
+    // records), where a leading BOM is data rather than an encoding mark.
+    CsvScanner(const char* data, size_t size, bool fileStart = true);
+
+    // Raw line without '\n' / trailing '\r'. A UTF-8 BOM at the start of the
+    // file is dropped.
+    bool nextLine(TextView& out);
+
+    // One CSV record: a quoted field (may span lines, "" -> ") with anything
+    // after the closing quote discarded up to the newline, or else a raw line.
+    bool nextRecord(TextView& out);
+
+    // Advances past one record exactly like nextRecord, without producing it
+    // (used to find record boundaries for chunked parsing).
+    bool skipRecord();
+
+    const char* position() const { return pos; }
+
+private:
+    const char* begin;   // nullptr when the buffer is not a file start
+    const char* pos;
+    const char* end;
+    std::string scratch;
+};
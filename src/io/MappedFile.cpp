@@ -0,0 +1,80 @@
+#include "io/MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { CloseHandle(f); return false; }
+    fileHandle = f;
+    opened = true;
+    if (sz.QuadPart == 0) return true;   // nothing to map
+
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) { close(); return false; }
+    mapHandle = m;
+
+    void* view = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { close(); return false; }
+    base = static_cast<const char*>(view);
+    length = static_cast<size_t>(sz.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (base) UnmapViewOfFile(base);
+    if (mapHandle) CloseHandle(static_cast<HANDLE>(mapHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    base = nullptr; length = 0; opened = false;
+    mapHandle = fileHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) { ::close(fd); return false; }
+    opened = true;
+    if (st.st_size == 0) { ::close(fd); return true; }   // nothing to map
+
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps its own reference
+    if (p == MAP_FAILED) { opened = false; return false; }
+    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    base = static_cast<const char*>(p);
+    length = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (base) ::munmap(const_cast<char*>(base), length);
+    base = nullptr; length = 0; opened = false;
+}
+
+#endif
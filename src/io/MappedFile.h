@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (Win32 file mapping or POSIX mmap).
+// An empty file opens successfully with size() == 0.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool        isOpen() const { return opened; }
+    const char* data() const { return base; }
+    size_t      size() const { return length; }
+
+private:
+    const char* base = nullptr;
+    size_t      length = 0;
+    bool        opened = false;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mapHandle = nullptr;
+#endif
+};
@@ -1,50 +1,27 @@
 #include "io/SingleColumnCsv.h"
+#include "io/CsvScanner.h"
+#include "io/MappedFile.h"
 #include <fstream>
 #include <string>
 
 
-namespace {
-static inline std::string to_lower(const std::string& s){
-std::string out; out.reserve(s.size());
-for(unsigned char c: s) out.push_back(static_cast<char>(std::tolower(c)));
-return out;
-}
-static inline std::string trim_quotes(const std::string& s){
-if(s.size()>=2 && s.front()=='"' && s.back()=='"'){
-std::string t; t.reserve(s.size());
-for(std::size_t i=1;i+1<s.size();++i){
-if(s[i]=='"' && i+1<s.size() && s[i+1]=='"'){ t.push_back('"'); ++i; }
-else t.push_back(s[i]);
-}
-return t;
-}
-return s;
-}
-}
-
-
 namespace ioutils {
 
 
 bool readSingleColumn(const std::string& path,
 const std::string& expectedHeader,
 DynamicArray<std::string>& out){
-std::ifstream in(path);
-if(!in.is_open()) return false;
-std::string line; bool first=true;
+MappedFile file;
+if(!file.open(path)) return false;
 out.clear();
-while(std::getline(in,line)){
-if(first){
-first=false;
-if(line.size()>=3 && (unsigned char)line[0]==0xEF && (unsigned char)line[1]==0xBB && (unsigned char)line[2]==0xBF){
-line = line.substr(3);
-}
+CsvScanner scan(file.data(), file.size());
+TextView rec;
 // Soft header check; do not fail hard.
 (void)expectedHeader; // header hint ignored on purpose
-continue;
-}
-if(line.empty()) continue;
-out.push_back(trim_quotes(line));
+if(!scan.nextLine(rec)) return true;
+while(scan.nextRecord(rec)){
+if(rec.empty()) continue;
+out.push_back(rec.str());
 }
 return true;
 }
@@ -0,0 +1,435 @@
+#include "io/Snapshot.h"
+#include "io/CsvReader.h"
+#include "io/MappedFile.h"
+#include "utils/TokenDictionary.h"
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using u32 = std::uint32_t;
+    using u64 = std::uint64_t;
+
+    const char kMagic[8] = { 'J', 'M', 'S', 'N', 'A', 'P', '\r', '\n' };
+    const u32 kByteOrder = 0x01020304u;   // reads back swapped on a foreign-endian host
+
+    // ---- on-disk layout (host byte order, every section 8-byte aligned) ----
+    struct StrRef { u32 off, len; };     // bytes in the blob
+    struct Span { u32 begin, count; };   // elements of an id / posting array
+
+    struct ResumeRec {
+        std::int32_t id;
+        StrRef name, skillText, degree;
+        Span   skillIds;                 // into the phrase-id array
+        u32    pad;
+        u64    bits[skills::kWords];
+    };
+
+    struct JobRec {
+        std::int32_t id;
+        StrRef title, required;
+        Span   skillIds;
+        u32    pad;
+        u64    bits[skills::kWords];
+    };
+
+    struct ListRec { StrRef token; Span rows; };   // one posting list
+    struct IndexRec { u32 rowCount; Span lists; };
+
+    enum { kResumeSkills, kJobTitle, kJobRequired, kIndexCount };
+
+    struct Header {
+        char magic[8];
+        u32 version, byteOrder;
+        u32 vocabSize, skillWords;
+        u64 vocabHash;                    // skills::vocabulary(), see vocabularyHash()
+        u64 resumesCsvSize; std::int64_t resumesCsvTime;
+        u64 jobsCsvSize;    std::int64_t jobsCsvTime;
+        u32 resumeCount, jobCount;
+        std::int32_t skippedResumes, skippedJobs;
+        u32 phraseCount, phraseIdCount;   // distinct skill phrases, per-row phrase ids
+        u32 listCount, postingCount;
+        IndexRec indexes[kIndexCount];
+        u32 pad;
+        u64 resumesOff, jobsOff, phrasesOff, phraseIdsOff, listsOff, postingsOff;
+        u64 blobOff, blobSize;
+    };
+    static_assert(sizeof(Header) % 8 == 0, "sections after the header must stay aligned");
+
+    // FNV-1a over the vocabulary phrases in bit order ('\0' after each): the
+    // stored bits and phrases mean nothing if an entry moved or changed.
+    static u64 vocabularyHash() {
+        u64 h = 14695981039346656037ULL;
+        const char* const* vocab = skills::vocabulary();
+        for (size_t i = 0; i < skills::kVocabSize; ++i) {
+            for (const char* c = vocab[i]; ; ++c) {
+                h = (h ^ (unsigned char)*c) * 1099511628211ULL;
+                if (*c == '\0') break;
+            }
+        }
+        return h;
+    }
+
+    static bool fileStamp(const std::string& path, u64& size, std::int64_t& mtime) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) return false;
+        size = (u64)st.st_size;
+        mtime = (std::int64_t)st.st_mtime;
+        return true;
+    }
+
+    // ---- save ----
+
+    // Collects the blob (strings stored once each) and the shared arrays
+    // while the records are built.
+    struct Builder {
+        std::string blob;
+        bool overflow = false;
+        std::unordered_map<std::string, StrRef> seen;
+
+        std::unordered_map<TokenId, u32> phraseOf;   // process id -> snapshot id
+        std::vector<StrRef> phrases;
+        std::vector<u32> phraseIds;
+
+        std::vector<ListRec> lists;
+        std::vector<u32> postings;
+
+        StrRef text(const std::string& s) {
+            auto it = seen.find(s);
+            if (it != seen.end()) return it->second;
+            if (blob.size() + s.size() > 0xFFFFFFFFu) { overflow = true; return StrRef{ 0, 0 }; }
+            const StrRef r{ (u32)blob.size(), (u32)s.size() };
+            blob += s;
+            seen.emplace(s, r);
+            return r;
+        }
+
+        // Token ids are only valid in this process, so rows store snapshot
+        // phrase ids and the phrase texts are saved once.
+        Span skillIds(const TokenIds& ids) {
+            const Span sp{ (u32)phraseIds.size(), (u32)ids.size() };
+            for (TokenId id : ids) {
+                auto it = phraseOf.find(id);
+                if (it == phraseOf.end()) {
+                    it = phraseOf.emplace(id, (u32)phrases.size()).first;
+                    phrases.push_back(text(TokenDictionary::global().text(id)));
+                }
+                phraseIds.push_back(it->second);
+            }
+            return sp;
+        }
+
+        IndexRec index(const InvertedIndex& ix) {
+            IndexRec rec{ (u32)ix.rowCount(), Span{ (u32)lists.size(), 0 } };
+            ix.forEachList([this](const std::string& token, const InvertedIndex::Postings& rows) {
+                lists.push_back(ListRec{ text(token), Span{ (u32)postings.size(), (u32)rows.size() } });
+                postings.insert(postings.end(), rows.begin(), rows.end());
+                });
+            rec.lists.count = (u32)lists.size() - rec.lists.begin;
+            return rec;
+        }
+    };
+
+    // Sequential writer that zero-pads up to each section offset.
+    struct SectionWriter {
+        std::ofstream& os;
+        u64 pos;
+
+        void put(u64 at, const void* p, size_t n) {
+            static const char zeros[8] = {};
+            while (pos < at) {
+                const size_t k = (size_t)std::min<u64>(sizeof(zeros), at - pos);
+                os.write(zeros, k);
+                pos += k;
+            }
+            if (n) os.write(static_cast<const char*>(p), n);
+            pos += n;
+        }
+    };
+
+    // ---- load ----
+
+    template<typename T>
+    static const T* sectionAt(const MappedFile& f, u64 off, u64 count) {
+        if (off % alignof(T) != 0 || off > f.size()) return nullptr;
+        if (count > (f.size() - off) / sizeof(T)) return nullptr;
+        return reinterpret_cast<const T*>(f.data() + off);
+    }
+
+    // Bounds-checked views over the mapped sections.
+    struct Reader {
+        const char* blob = nullptr;      u64 blobSize = 0;
+        const u32* phraseIds = nullptr;  u32 phraseIdCount = 0;
+        const ListRec* lists = nullptr;  u32 listCount = 0;
+        const u32* postings = nullptr;   u32 postingCount = 0;
+        std::vector<TokenId> processId;  // snapshot phrase id -> TokenDictionary id
+
+        bool text(const StrRef& r, std::string& out) const {
+            if ((u64)r.off + r.len > blobSize) return false;
+            out.assign(blob + r.off, r.len);
+            return true;
+        }
+
+        bool skillIds(const Span& s, TokenIds& out) const {
+            if ((u64)s.begin + s.count > phraseIdCount) return false;
+            out.clear();
+            out.reserve(s.count);
+            for (u32 k = 0; k < s.count; ++k) {
+                const u32 p = phraseIds[s.begin + k];
+                if (p >= processId.size()) return false;
+                out.push_back(processId[p]);
+            }
+            // re-interned ids need not keep the saved order
+            std::sort(out.begin(), out.end());
+            return true;
+        }
+
+        bool index(const IndexRec& rec, size_t rows, InvertedIndex& out) const {
+            if (rec.rowCount > rows || (u64)rec.lists.begin + rec.lists.count > listCount)
+                return false;
+            out.clear();
+            out.reserve(rec.lists.count);
+            std::string token;
+            for (u32 k = 0; k < rec.lists.count; ++k) {
+                const ListRec& l = lists[rec.lists.begin + k];
+                if (!text(l.token, token) || (u64)l.rows.begin + l.rows.count > postingCount)
+                    return false;
+                const u32* p = postings + l.rows.begin;
+                InvertedIndex::Postings list(p, p + l.rows.count);
+                for (u32 row : list) if (row >= rec.rowCount) return false;
+                out.assign(token, std::move(list));
+            }
+            out.setRowCount(rec.rowCount);
+            return true;
+        }
+    };
+
+    static bool reject(const std::string& path, const char* why) {
+        std::cerr << "[Snapshot] ignoring " << path << ": " << why << "\n";
+        return false;
+    }
+
+} // namespace
+
+bool Snapshot::save(const std::string& path,
+    const std::string& resumesCsv, const std::string& jobsCsv,
+    const ResumeLinkedList& resumes, const JobLinkedList& jobs) {
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byteOrder = kByteOrder;
+    h.vocabSize = (u32)skills::kVocabSize;
+    h.skillWords = (u32)skills::kWords;
+    h.vocabHash = vocabularyHash();
+    if (!fileStamp(resumesCsv, h.resumesCsvSize, h.resumesCsvTime) ||
+        !fileStamp(jobsCsv, h.jobsCsvSize, h.jobsCsvTime)) {
+        std::cerr << "[Snapshot] cannot stat the source CSVs, not saving\n";
+        return false;
+    }
+    h.skippedResumes = CsvReader::lastSkippedResumes;
+    h.skippedJobs = CsvReader::lastSkippedJobs;
+
+    Builder b;
+
+    // rows in insertion order, which is what the index postings refer to
+    std::vector<ResumeRec> resumeRecs(resumes.rowCount());
+    for (size_t row = 0; row < resumeRecs.size(); ++row) {
+        const auto& r = resumes.resumeAtRow(row);
+        ResumeRec& rec = resumeRecs[row];
+        rec.id = r.id;
+        rec.name = b.text(r.name);
+        rec.skillText = b.text(r.skills);
+        rec.degree = b.text(r.degree);
+        rec.skillIds = b.skillIds(r.skillIds);
+        std::memcpy(rec.bits, r.skillBits.w, sizeof(rec.bits));
+    }
+
+    std::vector<JobRec> jobRecs(jobs.rowCount());
+    for (size_t row = 0; row < jobRecs.size(); ++row) {
+        const auto& j = jobs.jobAtRow(row);
+        JobRec& rec = jobRecs[row];
+        rec.id = j.id;
+        rec.title = b.text(j.title);
+        rec.required = b.text(j.required);
+        rec.skillIds = b.skillIds(j.skillIds);
+        std::memcpy(rec.bits, j.skillBits.w, sizeof(rec.bits));
+    }
+
+    h.indexes[kResumeSkills] = b.index(resumes.skillsKeywords());
+    h.indexes[kJobTitle] = b.index(jobs.titleKeywords());
+    h.indexes[kJobRequired] = b.index(jobs.requiredKeywords());
+
+    if (b.overflow) {
+        std::cerr << "[Snapshot] dataset strings exceed 4 GiB, not saving\n";
+        return false;
+    }
+
+    h.resumeCount = (u32)resumeRecs.size();
+    h.jobCount = (u32)jobRecs.size();
+    h.phraseCount = (u32)b.phrases.size();
+    h.phraseIdCount = (u32)b.phraseIds.size();
+    h.listCount = (u32)b.lists.size();
+    h.postingCount = (u32)b.postings.size();
+
+    u64 pos = sizeof(Header);
+    auto place = [&pos](u64 bytes) {
+        pos = (pos + 7) & ~(u64)7;
+        const u64 at = pos;
+        pos += bytes;
+        return at;
+        };
+    h.resumesOff = place(resumeRecs.size() * sizeof(ResumeRec));
+    h.jobsOff = place(jobRecs.size() * sizeof(JobRec));
+    h.phrasesOff = place(b.phrases.size() * sizeof(StrRef));
+    h.phraseIdsOff = place(b.phraseIds.size() * sizeof(u32));
+    h.listsOff = place(b.lists.size() * sizeof(ListRec));
+    h.postingsOff = place(b.postings.size() * sizeof(u32));
+    h.blobOff = place(b.blob.size());
+    h.blobSize = b.blob.size();
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+        if (!os) {
+            std::cerr << "[Snapshot] cannot write: " << tmp << "\n";
+            return false;
+        }
+        SectionWriter out{ os, 0 };
+        out.put(0, &h, sizeof(h));
+        out.put(h.resumesOff, resumeRecs.data(), resumeRecs.size() * sizeof(ResumeRec));
+        out.put(h.jobsOff, jobRecs.data(), jobRecs.size() * sizeof(JobRec));
+        out.put(h.phrasesOff, b.phrases.data(), b.phrases.size() * sizeof(StrRef));
+        out.put(h.phraseIdsOff, b.phraseIds.data(), b.phraseIds.size() * sizeof(u32));
+        out.put(h.listsOff, b.lists.data(), b.lists.size() * sizeof(ListRec));
+        out.put(h.postingsOff, b.postings.data(), b.postings.size() * sizeof(u32));
+        out.put(h.blobOff, b.blob.data(), b.blob.size());
+        if (!os.flush()) {
+            std::cerr << "[Snapshot] write failed: " << tmp << "\n";
+            os.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());   // rename() does not replace on Windows
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cerr << "[Snapshot] cannot rename " << tmp << " -> " << path << "\n";
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::load(const std::string& path,
+    const std::string& resumesCsv, const std::string& jobsCsv,
+    ResumeLinkedList& resumes, JobLinkedList& jobs) {
+    resumes.clear();
+    jobs.clear();
+
+    MappedFile file;
+    if (!file.open(path)) return false;   // no snapshot yet
+    if (file.size() < sizeof(Header)) return reject(path, "truncated header");
+
+    Header h;
+    std::memcpy(&h, file.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.byteOrder != kByteOrder)
+        return reject(path, "not a snapshot for this host");
+    if (h.version != kVersion || h.vocabSize != skills::kVocabSize || h.skillWords != skills::kWords)
+        return reject(path, "written by another version");
+    if (h.vocabHash != vocabularyHash())
+        return reject(path, "written with another skill vocabulary");
+
+    u64 rs = 0, js = 0;
+    std::int64_t rt = 0, jt = 0;
+    if (!fileStamp(resumesCsv, rs, rt) || !fileStamp(jobsCsv, js, jt) ||
+        rs != h.resumesCsvSize || rt != h.resumesCsvTime ||
+        js != h.jobsCsvSize || jt != h.jobsCsvTime)
+        return reject(path, "source CSVs changed");
+
+    const ResumeRec* resumeRecs = sectionAt<ResumeRec>(file, h.resumesOff, h.resumeCount);
+    const JobRec* jobRecs = sectionAt<JobRec>(file, h.jobsOff, h.jobCount);
+    const StrRef* phrases = sectionAt<StrRef>(file, h.phrasesOff, h.phraseCount);
+
+    Reader rd;
+    rd.blob = sectionAt<char>(file, h.blobOff, h.blobSize);
+    rd.blobSize = h.blobSize;
+    rd.phraseIds = sectionAt<u32>(file, h.phraseIdsOff, h.phraseIdCount);
+    rd.phraseIdCount = h.phraseIdCount;
+    rd.lists = sectionAt<ListRec>(file, h.listsOff, h.listCount);
+    rd.listCount = h.listCount;
+    rd.postings = sectionAt<u32>(file, h.postingsOff, h.postingCount);
+    rd.postingCount = h.postingCount;
+    if (!resumeRecs || !jobRecs || !phrases || !rd.blob || !rd.phraseIds || !rd.lists || !rd.postings)
+        return reject(path, "corrupt section table");
+
+    bool ok = true;
+    std::string text;
+    rd.processId.reserve(h.phraseCount);
+    for (u32 i = 0; ok && i < h.phraseCount; ++i) {
+        ok = rd.text(phrases[i], text);
+        if (ok) rd.processId.push_back(TokenDictionary::global().intern(text));
+    }
+
+    for (u32 i = 0; ok && i < h.resumeCount; ++i) {
+        const ResumeRec& rec = resumeRecs[i];
+        ResumeLinkedList::Resume r;
+        r.id = rec.id;
+        ok = rd.text(rec.name, r.name) && rd.text(rec.skillText, r.skills) &&
+            rd.text(rec.degree, r.degree) && rd.skillIds(rec.skillIds, r.skillIds);
+        if (!ok) break;
+        std::memcpy(r.skillBits.w, rec.bits, sizeof(rec.bits));
+        ok = resumes.appendUnindexed(std::move(r));
+    }
+
+    for (u32 i = 0; ok && i < h.jobCount; ++i) {
+        const JobRec& rec = jobRecs[i];
+        JobLinkedList::Job j{};
+        j.id = rec.id;
+        ok = rd.text(rec.title, j.title) && rd.text(rec.required, j.required) &&
+            rd.skillIds(rec.skillIds, j.skillIds);
+        if (!ok) break;
+        std::memcpy(j.skillBits.w, rec.bits, sizeof(rec.bits));
+        ok = jobs.appendUnindexed(std::move(j));
+    }
+
+    InvertedIndex skillsIx, titleIx, requiredIx;
+    ok = ok && rd.index(h.indexes[kResumeSkills], resumes.rowCount(), skillsIx) &&
+        rd.index(h.indexes[kJobTitle], jobs.rowCount(), titleIx) &&
+        rd.index(h.indexes[kJobRequired], jobs.rowCount(), requiredIx);
+    if (!ok) {
+        resumes.clear();
+        jobs.clear();
+        return reject(path, "corrupt records");
+    }
+
+    resumes.adoptSkillsIndex(std::move(skillsIx));
+    jobs.adoptIndexes(std::move(titleIx), std::move(requiredIx));
+    CsvReader::lastSkippedResumes = h.skippedResumes;
+    CsvReader::lastSkippedJobs = h.skippedJobs;
+    return true;
+}
+
+Snapshot::LoadResult Snapshot::loadOrParse(const std::string& path,
+    const std::string& resumesCsv, const std::string& jobsCsv,
+    ResumeLinkedList& resumes, JobLinkedList& jobs, unsigned threads) {
+    LoadResult r;
+    r.fromSnapshot = load(path, resumesCsv, jobsCsv, resumes, jobs);
+    if (r.fromSnapshot) {
+        r.ok = true;
+        return r;
+    }
+    const bool okR = CsvReader::loadResumesParallel(resumesCsv, resumes, threads);
+    const bool okJ = CsvReader::loadJobsParallel(jobsCsv, jobs, threads);
+    r.ok = okR && okJ;
+    if (r.ok) r.saved = save(path, resumesCsv, jobsCsv, resumes, jobs);
+    return r;
+}
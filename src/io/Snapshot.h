@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "models/ResumeLinkedList.h"
+#include "models/JobLinkedList.h"
+
+// Versioned binary image of a loaded dataset: every string in one blob, the
+// extracted skill sets (bitsets + interned phrases) and the keyword indexes.
+// It is written after a CSV load and memory-mapped on the next start, so no
+// CSV parsing, skill extraction or index building has to run again.
+//
+// The size and mtime of both CSVs are stored in the header; a snapshot whose
+// sources changed (or with another version / skill vocabulary, compared by
+// a hash of the phrases in bit order) is rejected.
+namespace Snapshot {
+
+    constexpr std::uint32_t kVersion = 2;
+
+    // Writes via a temporary file and renames it over `path`.
+    bool save(const std::string& path,
+        const std::string& resumesCsv, const std::string& jobsCsv,
+        const ResumeLinkedList& resumes, const JobLinkedList& jobs);
+
+    // Replaces both lists (and CsvReader's skip counters) on success; leaves
+    // them empty and returns false when the snapshot is missing or stale.
+    bool load(const std::string& path,
+        const std::string& resumesCsv, const std::string& jobsCsv,
+        ResumeLinkedList& resumes, JobLinkedList& jobs);
+
+    struct LoadResult {
+        bool ok = false;             // both lists loaded
+        bool fromSnapshot = false;
+        bool saved = false;          // CSVs parsed and a new snapshot written
+    };
+
+    // The start-up load: the snapshot when it is current, otherwise both
+    // CSVs parsed on the pool (threads = 0 -> all cores) and a fresh
+    // snapshot saved for the next start.
+    LoadResult loadOrParse(const std::string& path,
+        const std::string& resumesCsv, const std::string& jobsCsv,
+        ResumeLinkedList& resumes, JobLinkedList& jobs, unsigned threads = 0);
+
+} // namespace Snapshot
@@ -0,0 +1,315 @@
+#include "io/Socket.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <csignal>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(_WIN32)
+    using Native = SOCKET;
+    const Native kBad = INVALID_SOCKET;
+
+    struct WinsockInit {
+        WinsockInit() { WSADATA d; WSAStartup(MAKEWORD(2, 2), &d); }
+        ~WinsockInit() { WSACleanup(); }
+    };
+    void startup() { static WinsockInit init; }
+
+    void closeNative(Native s) { ::closesocket(s); }
+    std::string lastError() { return "socket error " + std::to_string(WSAGetLastError()); }
+    bool interrupted() { return false; }
+
+    using PollFd = WSAPOLLFD;
+    const short kReadable = POLLRDNORM;
+    int pollMany(PollFd* fds, size_t n, int timeoutMs) {
+        return WSAPoll(fds, static_cast<ULONG>(n), timeoutMs);
+    }
+#else
+    using Native = int;
+    const Native kBad = -1;
+
+    // a peer that hangs up mid-reply must not kill the process
+    void startup() { static const bool once = (std::signal(SIGPIPE, SIG_IGN), true); (void)once; }
+
+    void closeNative(Native s) { ::close(s); }
+    std::string lastError() { return std::strerror(errno); }
+    bool interrupted() { return errno == EINTR; }
+
+    using PollFd = pollfd;
+    const short kReadable = POLLIN;
+    int pollMany(PollFd* fds, size_t n, int timeoutMs) {
+        int r;
+        do { r = ::poll(fds, static_cast<nfds_t>(n), timeoutMs); } while (r < 0 && errno == EINTR);
+        return r;
+    }
+#endif
+
+    // request / reply traffic: send small writes at once
+    void noDelay(Native s) {
+        int on = 1;
+        ::setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof on);
+    }
+
+} // namespace
+
+// ---- endpoint ----
+bool Endpoint::parse(const std::string& text, Endpoint& out) {
+    out = Endpoint();
+    if (text.compare(0, 5, "unix:") == 0) {
+#if defined(_WIN32)
+        return false;
+#else
+        out.unixPath = text.substr(5);
+        return !out.unixPath.empty() && out.unixPath.size() < sizeof(sockaddr_un().sun_path);
+#endif
+    }
+    const size_t colon = text.rfind(':');
+    const std::string portText = colon == std::string::npos ? text : text.substr(colon + 1);
+    if (colon != std::string::npos && colon > 0) out.host = text.substr(0, colon);
+    char* end = nullptr;
+    const long port = std::strtol(portText.c_str(), &end, 10);
+    if (portText.empty() || *end || port <= 0 || port > 65535) return false;
+    out.port = static_cast<unsigned short>(port);
+    return true;
+}
+
+std::string Endpoint::str() const {
+    if (!unixPath.empty()) return "unix:" + unixPath;
+    return host + ":" + std::to_string(port);
+}
+
+// ---- socket ----
+Socket::~Socket() { close(); }
+
+Socket::Socket(Socket&& other) noexcept
+    : handle(other.handle), inbox(std::move(other.inbox)), unixPath(std::move(other.unixPath)) {
+    other.handle = kInvalid;
+    other.unixPath.clear();
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this == &other) return *this;
+    close();
+    handle = other.handle;
+    inbox = std::move(other.inbox);
+    unixPath = std::move(other.unixPath);
+    other.handle = kInvalid;
+    other.unixPath.clear();
+    return *this;
+}
+
+bool Socket::valid() const { return handle != kInvalid; }
+
+void Socket::close() {
+    if (handle != kInvalid) closeNative(static_cast<Native>(handle));
+    handle = kInvalid;
+    inbox.clear();
+#if !defined(_WIN32)
+    if (!unixPath.empty()) ::unlink(unixPath.c_str());
+#endif
+    unixPath.clear();
+}
+
+Socket Socket::listen(const Endpoint& at, std::string& error) {
+    startup();
+    Socket s;
+    if (!at.unixPath.empty()) {
+#if defined(_WIN32)
+        error = "Unix sockets are not supported here";
+        return s;
+#else
+        const Native fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == kBad) { error = lastError(); return s; }
+        s.handle = fd;
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, at.unixPath.c_str(), sizeof addr.sun_path - 1);
+        ::unlink(at.unixPath.c_str());   // stale socket from an earlier run
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            error = lastError();
+            s.close();
+            return s;
+        }
+        s.unixPath = at.unixPath;
+#endif
+    }
+    else {
+        const Native fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (fd == kBad) { error = lastError(); return s; }
+        s.handle = static_cast<Handle>(fd);
+        int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof on);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(at.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);   // never exposed beyond this host
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            error = lastError();
+            s.close();
+            return s;
+        }
+    }
+    if (::listen(static_cast<Native>(s.handle), 64) != 0) {
+        error = lastError();
+        s.close();
+    }
+    return s;
+}
+
+Socket Socket::connect(const Endpoint& to, std::string& error) {
+    startup();
+    Socket s;
+    if (!to.unixPath.empty()) {
+#if defined(_WIN32)
+        error = "Unix sockets are not supported here";
+#else
+        const Native fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == kBad) { error = lastError(); return s; }
+        s.handle = fd;
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, to.unixPath.c_str(), sizeof addr.sun_path - 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            error = lastError();
+            s.close();
+        }
+#endif
+        return s;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    const std::string port = std::to_string(to.port);
+    if (::getaddrinfo(to.host.c_str(), port.c_str(), &hints, &found) != 0 || !found) {
+        error = "cannot resolve " + to.host;
+        return s;
+    }
+    for (addrinfo* a = found; a; a = a->ai_next) {
+        const Native fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd == kBad) continue;
+        if (::connect(fd, a->ai_addr, static_cast<int>(a->ai_addrlen)) == 0) {
+            noDelay(fd);
+            s.handle = static_cast<Handle>(fd);
+            break;
+        }
+        closeNative(fd);
+    }
+    ::freeaddrinfo(found);
+    if (!s.valid()) error = "cannot connect to " + to.str() + ": " + lastError();
+    return s;
+}
+
+int Socket::waitReadable(int timeoutMs) const {
+    if (!valid()) return -1;
+    PollFd p{};
+    p.fd = static_cast<Native>(handle);
+    p.events = kReadable;
+    const int r = pollMany(&p, 1, timeoutMs);
+    return r > 0 ? 1 : (r == 0 ? 0 : -1);
+}
+
+int Socket::waitAny(const std::vector<const Socket*>& sockets, int timeoutMs,
+    std::vector<char>& readable) {
+    std::vector<PollFd> fds(sockets.size());
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        fds[i].fd = static_cast<Native>(sockets[i]->handle);
+        fds[i].events = kReadable;
+    }
+    const int r = pollMany(fds.data(), fds.size(), timeoutMs);
+    readable.assign(sockets.size(), 0);
+    if (r <= 0) return r < 0 ? -1 : 0;
+    for (size_t i = 0; i < fds.size(); ++i)
+        readable[i] = fds[i].revents != 0;
+    return r;
+}
+
+Socket Socket::accept() const {
+    const Native fd = ::accept(static_cast<Native>(handle), nullptr, nullptr);
+    if (fd == kBad) return Socket();
+    if (unixPath.empty()) noDelay(fd);
+    return Socket(static_cast<Handle>(fd));
+}
+
+void Socket::setSendTimeout(int timeoutMs) const {
+#if defined(_WIN32)
+    const DWORD t = static_cast<DWORD>(timeoutMs);
+#else
+    timeval t{};
+    t.tv_sec = timeoutMs / 1000;
+    t.tv_usec = (timeoutMs % 1000) * 1000;
+#endif
+    ::setsockopt(static_cast<Native>(handle), SOL_SOCKET, SO_SNDTIMEO,
+        reinterpret_cast<const char*>(&t), sizeof t);
+}
+
+void Socket::shutdown() const {
+#if defined(_WIN32)
+    ::shutdown(static_cast<Native>(handle), SD_BOTH);
+#else
+    ::shutdown(static_cast<Native>(handle), SHUT_RDWR);
+#endif
+}
+
+bool Socket::sendAll(const char* data, size_t size) const {
+    while (size > 0) {
+        const int chunk = size > (1u << 30) ? (1 << 30) : static_cast<int>(size);
+        const int n = static_cast<int>(::send(static_cast<Native>(handle), data, chunk, 0));
+        if (n < 0 && interrupted()) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int Socket::receive() {
+    char buf[4096];
+    int n;
+    do { n = static_cast<int>(::recv(static_cast<Native>(handle), buf, sizeof buf, 0)); }
+    while (n < 0 && interrupted());
+    if (n <= 0) return -1;
+    inbox.append(buf, static_cast<size_t>(n));
+    return n;
+}
+
+bool Socket::takeLine(std::string& line) {
+    const size_t nl = inbox.find('\n');
+    if (nl == std::string::npos) return false;
+    line.assign(inbox, 0, nl);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    inbox.erase(0, nl + 1);
+    return true;
+}
+
+int Socket::readLine(std::string& line, int timeoutMs) {
+    while (!takeLine(line)) {
+        const int ready = waitReadable(timeoutMs);
+        if (ready <= 0) return ready;
+        if (receive() < 0) return -1;
+    }
+    return 1;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Where a server listens / a client connects: "unix:/path/to.sock" (POSIX
+// only), "host:port" or a bare port (127.0.0.1). Servers only ever bind the
+// loopback address.
+struct Endpoint {
+    std::string    unixPath;   // non-empty = Unix domain socket
+    std::string    host = "127.0.0.1";
+    unsigned short port = 0;
+
+    static bool parse(const std::string& text, Endpoint& out);
+    std::string str() const;
+};
+
+// Blocking stream socket (Winsock or BSD) with '\n'-framed reads, for the
+// match server and its load generator. Move-only; closes on destruction.
+// receive() and sendAll() may run on different threads at once.
+class Socket {
+public:
+    Socket() = default;
+    ~Socket();
+    Socket(Socket&& other) noexcept;
+    Socket& operator=(Socket&& other) noexcept;
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    static Socket listen(const Endpoint& at, std::string& error);
+    static Socket connect(const Endpoint& to, std::string& error);
+
+    bool valid() const;
+    void close();
+
+    // 1 = readable (or a connection to accept), 0 = timed out, -1 = error.
+    int waitReadable(int timeoutMs) const;
+    // Polls every socket at once; readable[i] is set for those ready (or
+    // hung up). Returns how many are, 0 on timeout, -1 on error.
+    static int waitAny(const std::vector<const Socket*>& sockets, int timeoutMs,
+        std::vector<char>& readable);
+    Socket accept() const;
+
+    // Makes a send that cannot progress for `timeoutMs` fail instead of
+    // blocking (SO_SNDTIMEO), so sendAll() returns false on a stalled peer.
+    void setSendTimeout(int timeoutMs) const;
+    // Ends both directions without closing the handle: a thread blocked in
+    // or polling this socket wakes up and sees the hang-up.
+    void shutdown() const;
+
+    bool sendAll(const char* data, size_t size) const;
+    bool sendAll(const std::string& data) const { return sendAll(data.data(), data.size()); }
+
+    // Next line without its '\n' (a trailing '\r' is dropped too).
+    // 1 = line, 0 = timed out with no full line yet, -1 = closed or error.
+    int readLine(std::string& line, int timeoutMs);
+
+    // One read of whatever has arrived, buffered for takeLine(); blocks if
+    // nothing has. Bytes read, or -1 when the peer closed or on error.
+    int receive();
+    // Next buffered line, if a whole one has been received.
+    bool takeLine(std::string& line);
+    // Bytes received but not yet returned as a line.
+    size_t buffered() const { return inbox.size(); }
+
+private:
+    using Handle = std::intptr_t;
+    static const Handle kInvalid = -1;
+
+    explicit Socket(Handle h) : handle(h) {}
+
+    Handle      handle = kInvalid;
+    std::string inbox;      // bytes received past the last returned line
+    std::string unixPath;   // listening Unix socket, unlinked on close
+};
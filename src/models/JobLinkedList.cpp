@@ -1,65 +1,110 @@
 #include "JobLinkedList.h"
+#include "utils/CiPattern.h"
 #include <iostream>
 #include <algorithm>
-#include <cctype>
+#include <iterator>
 
-static std::string toLowerCopy(const std::string& s) {
-    std::string out = s;
-    std::transform(out.begin(), out.end(), out.begin(),
-        [](unsigned char c) { return std::tolower(c); });
-    return out;
-}
-
-JobLinkedList::JobLinkedList() : head(nullptr) {}
+JobLinkedList::JobLinkedList() : head(nullptr), tail(nullptr) {}
 JobLinkedList::~JobLinkedList() { clear(); }
 
+void JobLinkedList::computeFeatures(Job& job) {
+    tokens::skillIds(job.required, job.skillIds);
+    job.skillBits = skills::fromList(job.required);
+}
+
 void JobLinkedList::insertJob(int id, const std::string& title, const std::string& required) {
-    if (id <= 0 || title.empty() || required.empty()) {
+    Job job{ id, title, required, {}, {} };
+    computeFeatures(job);
+    insertJob(std::move(job));
+}
+
+void JobLinkedList::insertJob(Job&& job) {
+    if (!appendUnindexed(std::move(job))) return;
+
+    const auto row = static_cast<InvertedIndex::Row>(rowNodes.size() - 1);
+    const Job& added = rowNodes.back()->data;
+    titleIndex.add(row, added.title);
+    requiredIndex.add(row, added.required);
+}
+
+bool JobLinkedList::appendUnindexed(Job&& job) {
+    const int id = job.id;
+    if (id <= 0 || job.title.empty() || job.required.empty()) {
         std::cerr << "[JobLinkedList] Invalid data, skipping.\n";
-        return;
+        return false;
     }
 
-    Node* cur = head;
-    while (cur) {
-        if (cur->data.id == id) {
-            std::cerr << "[JobLinkedList] Duplicate Job ID: " << id << std::endl;
-            return;
-        }
-        cur = cur->next;
+    const auto row = static_cast<InvertedIndex::Row>(rowNodes.size());
+    if (!ids.insert(id, row)) {
+        std::cerr << "[JobLinkedList] Duplicate Job ID: " << id << std::endl;
+        return false;
     }
 
-    Node* newNode = new Node{ {id, title, required}, nullptr };
+    Node* newNode = nodes.create(std::move(job), nullptr);
     if (!head)
-        head = newNode;
+        head = tail = newNode;
     else {
-        Node* p = head;
-        while (p->next) p = p->next;
-        p->next = newNode;
+        tail->next = newNode;
+        tail = newNode;
     }
+
+    rowNodes.push_back(newNode);
+    titleOrder.add(row);
+    skillRows.push_back(newNode->data.skillBits);
+    return true;
+}
+
+void JobLinkedList::adoptIndexes(InvertedIndex&& title, InvertedIndex&& required) {
+    titleIndex = std::move(title);
+    requiredIndex = std::move(required);
 }
 
 JobLinkedList::Job* JobLinkedList::searchById(int id) const {
-    Node* cur = head;
-    while (cur) {
-        if (cur->data.id == id)
-            return &cur->data;
-        cur = cur->next;
-    }
-    return nullptr;
+    IdIndex::Slot row;
+    if (!ids.find(id, row)) return nullptr;
+    return &rowNodes[row]->data;
 }
 
 JobLinkedList::Job* JobLinkedList::searchByKeyword(const std::string& keyword) const {
     if (keyword.empty()) return nullptr;
-    std::string k = toLowerCopy(keyword);
-    Node* cur = head;
-    while (cur) {
-        std::string t = toLowerCopy(cur->data.title);
-        std::string r = toLowerCopy(cur->data.required);
-        if (t.find(k) != std::string::npos || r.find(k) != std::string::npos)
-            return &cur->data;
-        cur = cur->next;
+    std::vector<const Job*> hits;
+    if (searchAllByKeyword(keyword, Field::TitleOrRequired, hits) == 0) return nullptr;
+    return const_cast<Job*>(hits.front());
+}
+
+size_t JobLinkedList::searchAllByKeyword(const std::string& keyword, Field field,
+    std::vector<const Job*>& out) const {
+    out.clear();
+    const CiPattern pat(keyword);
+    const std::string& k = pat.folded();
+    const bool useTitle = field != Field::Required;
+    const bool useRequired = field != Field::Title;
+
+    InvertedIndex::Postings rows, t, r;
+    bool exact = true;
+    if (useTitle && useRequired) {
+        bool et = titleIndex.candidates(k, t);
+        bool er = requiredIndex.candidates(k, r);
+        std::set_union(t.begin(), t.end(), r.begin(), r.end(), std::back_inserter(rows));
+        exact = et && er;
     }
-    return nullptr;
+    else if (useTitle) {
+        exact = titleIndex.candidates(k, rows);
+    }
+    else {
+        exact = requiredIndex.candidates(k, rows);
+    }
+
+    out.reserve(rows.size());
+    for (InvertedIndex::Row row : rows) {
+        const Job& j = rowNodes[row]->data;
+        if (!exact &&
+            !(useTitle && pat.foundIn(j.title)) &&
+            !(useRequired && pat.foundIn(j.required)))
+            continue;
+        out.push_back(&j);
+    }
+    return out.size();
 }
 
 void JobLinkedList::displayJobs(int pageSize) const {
@@ -76,47 +121,55 @@ void JobLinkedList::displayJobs(int pageSize) const {
         std::cout << "---- Jobs ----\n";
     }
 
-    const Node* p = head;
-    int printedOnPage = 0;
-    long long printedTotal = 0;
-
-    while (p) {
-        std::cout << p->data.id << " | " << p->data.title
-            << " | " << p->data.required << std::endl;
-
-        ++printedOnPage;
-        ++printedTotal;
-
-        if (pageSize > 0 && printedOnPage >= pageSize) {
-            if (!p->next) break;
-
-            std::cout << "--------------------------\n"
-                << "[n] next page  [q] quit > ";
-            char cmd{};
-            if (!(std::cin >> cmd)) {
-                std::cin.clear();
-                std::cin.ignore(10000, '\n');
-                break;
-            }
+    const size_t perPage = pageSize > 0 ? static_cast<size_t>(pageSize) : rowNodes.size();
+    Cursor c = cursor();
+    while (page(c, perPage, [](const Job& j) {
+        std::cout << j.id << " | " << j.title
+            << " | " << j.required << std::endl;
+        })) {
+        if (c.atEnd()) break;
+
+        std::cout << "--------------------------\n"
+            << "[n] next page  [q] quit > ";
+        char cmd{};
+        if (!(std::cin >> cmd)) {
+            std::cin.clear();
             std::cin.ignore(10000, '\n');
-
-            if (cmd == 'q' || cmd == 'Q') {
-                std::cout << "[i] Stopped after " << printedTotal << " rows.\n";
-                return;
-            }
-            printedOnPage = 0;
+            break;
         }
+        std::cin.ignore(10000, '\n');
 
-        p = p->next;
+        if (cmd == 'q' || cmd == 'Q') {
+            std::cout << "[i] Stopped after " << c.offset() << " rows.\n";
+            return;
+        }
     }
 
     std::cout << "--------------------------\n";
 }
 
+JobLinkedList::Cursor JobLinkedList::cursor(size_t offset) const {
+    Cursor c;
+    c.pos = offset < rowNodes.size() ? offset : rowNodes.size();
+    if (offset < rowNodes.size()) c.node = rowNodes[offset];
+    return c;
+}
+
 void JobLinkedList::clear() {
-    while (head) {
-        Node* tmp = head;
-        head = head->next;
-        delete tmp;
-    }
+    nodes.clear();
+    head = tail = nullptr;
+    ids.clear();
+    rowNodes.clear();
+    titleIndex.clear();
+    requiredIndex.clear();
+    titleOrder.clear();
+    skillRows.clear();
+}
+
+const SortedIndex& JobLinkedList::byTitle() const {
+    titleOrder.settle([this](SortedIndex::Row r) {
+        const std::string& s = rowNodes[r]->data.title;
+        return TextView{ s.data(), s.size() };
+    });
+    return titleOrder;
 }
@@ -3,6 +3,13 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include "utils/IdIndex.h"
+#include "utils/InvertedIndex.h"
+#include "utils/SlabPool.h"
+#include "utils/SortedIndex.h"
+#include "utils/TokenDictionary.h"
+#include "utils/SkillBits.h"
 
 class JobLinkedList {
 public:
@@ -10,6 +17,8 @@ public:
         int id;
         std::string title;
         std::string required;
+        TokenIds skillIds;   // interned skill phrases of `required`, set on insert
+        skills::SkillBits skillBits;   // vocabulary bitset of `required`
     };
 
 private:
@@ -17,17 +26,55 @@ private:
         Job data;
         Node* next;
     };
+    SlabPool<Node> nodes;   // nodes live in slabs, freed together by clear()
     Node* head;
+    Node* tail;
+    IdIndex ids;   // job id -> row
+
+    // row ordinal (insertion order) -> node, plus per-field keyword indexes
+    std::vector<Node*> rowNodes;
+    InvertedIndex titleIndex;
+    InvertedIndex requiredIndex;
+    mutable SortedIndex titleOrder;   // rows by title, settled by byTitle()
+    skills::SkillMatrix skillRows;   // skillBits by row, for the batch kernel
 
 public:
+    enum class Field { Title, Required, TitleOrRequired };
+
     JobLinkedList();
     ~JobLinkedList();
 
     void insertJob(int id, const std::string& title, const std::string& required);
 
+    // Bulk-load path: features are computed off-list (any thread), then the
+    // prepared job is moved in without recomputing them.
+    static void computeFeatures(Job& job);
+    void insertJob(Job&& job);
+
+    // Snapshot path: prepared jobs are appended without touching the keyword
+    // indexes, then the saved indexes are installed in one step.
+    bool appendUnindexed(Job&& job);
+    void adoptIndexes(InvertedIndex&& title, InvertedIndex&& required);
+    const InvertedIndex& titleKeywords() const { return titleIndex; }
+    const InvertedIndex& requiredKeywords() const { return requiredIndex; }
+
     JobLinkedList::Job* searchById(int id) const;
     JobLinkedList::Job* searchByKeyword(const std::string& keyword) const;
 
+    // All jobs whose field contains keyword (case-insensitive), in insertion
+    // order. Answered from the inverted indexes; returns the hit count.
+    size_t searchAllByKeyword(const std::string& keyword, Field field,
+        std::vector<const Job*>& out) const;
+
+    // Row-ordered views for bulk scoring (row = insertion order).
+    const skills::SkillMatrix& skillMatrix() const { return skillRows; }
+    const Job& jobAtRow(size_t row) const { return rowNodes[row]->data; }
+    size_t rowCount() const { return rowNodes.size(); }
+
+    // Rows in title order (byte order, ties by row). Key-sorted on first use
+    // after a load; later inserts are merged in on the next call.
+    const SortedIndex& byTitle() const;
+
     void displayJobs(int pageSize = 0) const;  // 0 = no paging
     void clear();
 
@@ -36,6 +83,34 @@ public:
         for (Node* p = head; p; p = p->next)
             fn(p->data);
     }
+
+    // ---- paging ----
+    // Resumable position in list order (head -> tail). A page picks up from a
+    // saved cursor, and cursor(offset) lands on any position in O(1) through
+    // the row table (jobs are never relinked, so rows are list order), so a
+    // deep page costs the same as the first one. clear() invalidates cursors.
+    class Cursor {
+    public:
+        size_t offset() const { return pos; }
+        bool   atEnd() const { return node == nullptr; }
+    private:
+        friend class JobLinkedList;
+        const Node* node = nullptr;
+        size_t      pos = 0;
+    };
+
+    Cursor cursor(size_t offset = 0) const;
+
+    // Calls fn on up to n jobs from c and advances c; returns how many.
+    template<typename Fn>
+    size_t page(Cursor& c, size_t n, Fn fn) const {
+        size_t done = 0;
+        for (; c.node && done < n; ++done, ++c.pos) {
+            fn(c.node->data);
+            c.node = c.node->next;
+        }
+        return done;
+    }
 };
 
 #endif
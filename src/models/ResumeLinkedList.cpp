@@ -1,4 +1,6 @@
 ﻿#include "models/ResumeLinkedList.h"
+#include "utils/CiPattern.h"
+#include "utils/KeySort.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
@@ -10,8 +12,8 @@ char ResumeLinkedList::toLowerChar(char c) {
 int ResumeLinkedList::ciCmp(const std::string& a, const std::string& b) {
     const size_t n = (a.size() < b.size()) ? a.size() : b.size();
     for (size_t i = 0; i < n; ++i) {
-        const char ca = toLowerChar(a[i]);
-        const char cb = toLowerChar(b[i]);
+        const unsigned char ca = static_cast<unsigned char>(toLowerChar(a[i]));
+        const unsigned char cb = static_cast<unsigned char>(toLowerChar(b[i]));
         if (ca < cb) return -1;
         if (ca > cb) return 1;
     }
@@ -23,33 +25,56 @@ int ResumeLinkedList::ciCmp(const std::string& a, const std::string& b) {
 ResumeLinkedList::~ResumeLinkedList() { clear(); }
 
 ResumeLinkedList::ResumeLinkedList(ResumeLinkedList&& other) noexcept {
+    nodes.swap(other.nodes);
     head = other.head;
     tail = other.tail;
     count = other.count;
+    rowNodes.swap(other.rowNodes);
+    ids = std::move(other.ids);
+    skillsIndex = std::move(other.skillsIndex);
+    nameOrder = std::move(other.nameOrder);
+    relinked = other.relinked;
+    listNodes.swap(other.listNodes);
     other.head = other.tail = nullptr;
     other.count = 0;
+    other.ids.clear();
+    other.skillsIndex.clear();
+    other.nameOrder.clear();
+    other.relinked = false;
 }
 
 ResumeLinkedList& ResumeLinkedList::operator=(ResumeLinkedList&& other) noexcept {
     if (this == &other) return *this;
     clear();
+    nodes.swap(other.nodes);
     head = other.head;
     tail = other.tail;
     count = other.count;
+    rowNodes.swap(other.rowNodes);
+    ids = std::move(other.ids);
+    skillsIndex = std::move(other.skillsIndex);
+    nameOrder = std::move(other.nameOrder);
+    relinked = other.relinked;
+    listNodes.swap(other.listNodes);
     other.head = other.tail = nullptr;
     other.count = 0;
+    other.ids.clear();
+    other.skillsIndex.clear();
+    other.nameOrder.clear();
+    other.relinked = false;
     return *this;
 }
 
 void ResumeLinkedList::clear() {
-    Node* p = head;
-    while (p) {
-        Node* nxt = p->next;
-        delete p;
-        p = nxt;
-    }
+    nodes.clear();
     head = tail = nullptr;
     count = 0;
+    rowNodes.clear();
+    ids.clear();
+    skillsIndex.clear();
+    nameOrder.clear();
+    relinked = false;
+    listNodes.clear();
 }
 
 void ResumeLinkedList::insertResume(int id,
@@ -58,8 +83,27 @@ void ResumeLinkedList::insertResume(int id,
     const std::string& degree) {
     if (id <= 0 || name.empty()) return;
 
-    Node* n = new Node(Resume{ id, name, skills, degree });
-    n->next = nullptr;
+    Resume r{ id, name, skills, degree, {}, {} };
+    computeFeatures(r);
+    insertResume(std::move(r));
+}
+
+void ResumeLinkedList::computeFeatures(Resume& r) {
+    tokens::skillIds(r.skills, r.skillIds);
+    r.skillBits = skills::fromList(r.skills);
+}
+
+void ResumeLinkedList::insertResume(Resume&& r) {
+    if (!appendUnindexed(std::move(r))) return;
+
+    const auto row = static_cast<InvertedIndex::Row>(rowNodes.size() - 1);
+    skillsIndex.add(row, rowNodes.back()->data.skills);
+}
+
+bool ResumeLinkedList::appendUnindexed(Resume&& r) {
+    if (r.id <= 0 || r.name.empty()) return false;
+
+    Node* n = nodes.create(std::move(r));
 
     if (!head) {
         head = tail = n;
@@ -69,6 +113,61 @@ void ResumeLinkedList::insertResume(int id,
         tail = n;
     }
     ++count;
+
+    const auto row = static_cast<SortedIndex::Row>(rowNodes.size());
+    ids.insert(n->data.id, row);
+    nameOrder.add(row);
+    rowNodes.push_back(n);
+    if (relinked && listNodes.size() + 1 == count) listNodes.push_back(n);
+    return true;
+}
+
+const std::vector<ResumeLinkedList::Node*>& ResumeLinkedList::offsets() const {
+    if (!relinked) return rowNodes;
+    if (listNodes.size() != count) {
+        listNodes.clear();
+        listNodes.reserve(count);
+        for (Node* p = head; p; p = p->next) listNodes.push_back(p);
+    }
+    return listNodes;
+}
+
+ResumeLinkedList::Cursor ResumeLinkedList::cursor(size_t offset) const {
+    Cursor c;
+    c.pos = offset < count ? offset : count;
+    if (offset < count) c.node = offsets()[offset];
+    return c;
+}
+
+const ResumeLinkedList::Resume* ResumeLinkedList::searchById(int id) const {
+    IdIndex::Slot row;
+    if (!ids.find(id, row)) return nullptr;
+    return &rowNodes[row]->data;
+}
+
+const SortedIndex& ResumeLinkedList::byName() const {
+    nameOrder.settle([this](SortedIndex::Row r) {
+        const std::string& s = rowNodes[r]->data.name;
+        return TextView{ s.data(), s.size() };
+    });
+    return nameOrder;
+}
+
+size_t ResumeLinkedList::searchBySkill(const std::string& keyword,
+    std::vector<const Resume*>& out) const {
+    out.clear();
+    const CiPattern pat(keyword);
+    const std::string& k = pat.folded();
+
+    InvertedIndex::Postings rows;
+    const bool exact = skillsIndex.candidates(k, rows);
+
+    out.reserve(rows.size());
+    for (InvertedIndex::Row row : rows) {
+        const Resume& r = rowNodes[row]->data;
+        if (exact || pat.foundIn(r.skills)) out.push_back(&r);
+    }
+    return out.size();
 }
 
 void ResumeLinkedList::displayResumes(int pageSize) const {
@@ -85,40 +184,30 @@ void ResumeLinkedList::displayResumes(int pageSize) const {
         std::cout << "---- Resumes (" << count << ") ----\n";
     }
 
-    const Node* p = head;
-    int        printedOnPage = 0;
-    long long  printedTotal = 0;
-
-    while (p) {
-        std::cout << "ID: " << p->data.id
-            << " | Name: " << p->data.name
-            << " | Degree: " << p->data.degree
-            << " | Skills: " << p->data.skills << "\n";
-
-        ++printedOnPage;
-        ++printedTotal;
-
-        if (pageSize > 0 && printedOnPage >= pageSize) {
-            if (!p->next) break;
-
-            std::cout << "--------------------------\n"
-                << "[n] next page • [q] quit > ";
-            char cmd{};
-            if (!(std::cin >> cmd)) {
-                std::cin.clear();
-                std::cin.ignore(10000, '\n');
-                break;
-            }
+    const size_t perPage = pageSize > 0 ? static_cast<size_t>(pageSize) : count;
+    Cursor c = cursor();
+    while (page(c, perPage, [](const Resume& r) {
+        std::cout << "ID: " << r.id
+            << " | Name: " << r.name
+            << " | Degree: " << r.degree
+            << " | Skills: " << r.skills << "\n";
+        })) {
+        if (c.atEnd()) break;
+
+        std::cout << "--------------------------\n"
+            << "[n] next page • [q] quit > ";
+        char cmd{};
+        if (!(std::cin >> cmd)) {
+            std::cin.clear();
             std::cin.ignore(10000, '\n');
-
-            if (cmd == 'q' || cmd == 'Q') {
-                std::cout << "[i] Stopped after " << printedTotal << " rows.\n";
-                return;
-            }
-            printedOnPage = 0;
+            break;
         }
+        std::cin.ignore(10000, '\n');
 
-        p = p->next;
+        if (cmd == 'q' || cmd == 'Q') {
+            std::cout << "[i] Stopped after " << c.offset() << " rows.\n";
+            return;
+        }
     }
 
     std::cout << "--------------------------\n";
@@ -130,7 +219,7 @@ void ResumeLinkedList::mergeSortByName(bool /*verbose*/) {
     size_t length = 0;
     for (Node* p = head; p; p = p->next) ++length;
 
-    Node dummy(Resume{ 0, "", "", "" });
+    Node dummy(Resume{ 0, "", "", "", {}, {} });
 
     for (size_t step = 1; step < length; step <<= 1) {
         Node* cur = head;
@@ -181,10 +270,39 @@ void ResumeLinkedList::mergeSortByName(bool /*verbose*/) {
         }
 
         head = dummy.next;
+        tail = tailM;   // the last merge ran to the end of the list
+    }
+    relinked = true;
+    listNodes.clear();
+}
 
-        tail = head;
-        while (tail && tail->next) tail = tail->next;
+void ResumeLinkedList::sortByName(unsigned threads) {
+    if (!head || !head->next) return;
+
+    std::vector<Node*> order;
+    std::vector<TextView> keys;
+    order.reserve(count);
+    keys.reserve(count);
+    for (Node* p = head; p; p = p->next) {
+        order.push_back(p);
+        keys.push_back(TextView{ p->data.name.data(), p->data.name.size() });
     }
+
+    std::vector<std::uint32_t> sorted;
+    keysort::order(keys, true, threads, sorted);
+
+    head = order[sorted[0]];
+    Node* last = head;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        last->next = order[sorted[i]];
+        last = last->next;
+    }
+    last->next = nullptr;
+    tail = last;
+
+    relinked = true;
+    listNodes.resize(count);
+    for (size_t i = 0; i < sorted.size(); ++i) listNodes[i] = order[sorted[i]];
 }
 
 ResumeLinkedList ResumeLinkedList::clone() const {
@@ -1,6 +1,14 @@
 ﻿#pragma once
 #include <string>
 #include <cstddef>
+#include <utility>
+#include <vector>
+#include "utils/IdIndex.h"
+#include "utils/InvertedIndex.h"
+#include "utils/SlabPool.h"
+#include "utils/SortedIndex.h"
+#include "utils/TokenDictionary.h"
+#include "utils/SkillBits.h"
 
 class ResumeLinkedList {
 public:
@@ -9,6 +17,8 @@ public:
         std::string name;
         std::string skills;   
         std::string degree;
+        TokenIds    skillIds;   // interned skill phrases of `skills`, set on insert
+        skills::SkillBits skillBits;   // vocabulary bitset of `skills`
     };
 
 private:
@@ -16,12 +26,26 @@ private:
         Resume data;
         Node* next;
         explicit Node(const Resume& r) : data(r), next(nullptr) {}
+        explicit Node(Resume&& r) : data(std::move(r)), next(nullptr) {}
     };
 
+    SlabPool<Node> nodes;   // nodes live in slabs, freed together by clear()
     Node* head = nullptr;
     Node* tail = nullptr;
     size_t count = 0;
 
+    // row ordinal (insertion order) -> node; rows survive re-linking by sorts
+    std::vector<Node*> rowNodes;
+    IdIndex ids;   // resume id -> row (first row on a duplicate id)
+    InvertedIndex skillsIndex;
+    mutable SortedIndex nameOrder;   // rows by name, settled by byName()
+
+    // list position -> node. Until a sort relinks the list, rowNodes is
+    // already in list order; after one, listNodes is rebuilt on demand.
+    bool relinked = false;
+    mutable std::vector<Node*> listNodes;
+    const std::vector<Node*>& offsets() const;
+
 public:
     // ---- lifecycle ----
     ResumeLinkedList() = default;
@@ -40,10 +64,41 @@ public:
         const std::string& skills,
         const std::string& degree);
 
-    void displayResumes(int pageSize = 0) const;
+    // Bulk-load path: features are computed off-list (any thread), then the
+    // prepared resume is moved in without recomputing them.
+    static void computeFeatures(Resume& r);
+    void insertResume(Resume&& r);
+
+    // Snapshot path: prepared resumes are appended without touching the
+    // skills index, then the saved index is installed in one step.
+    bool appendUnindexed(Resume&& r);
+    void adoptSkillsIndex(InvertedIndex&& index) { skillsIndex = std::move(index); }
+    const InvertedIndex& skillsKeywords() const { return skillsIndex; }
+
+    // Insertion-order view (rows are not moved by sorts).
+    const Resume& resumeAtRow(size_t row) const { return rowNodes[row]->data; }
+    size_t rowCount() const { return rowNodes.size(); }
+
+    // Rows in name order (byte order, ties by row). Key-sorted on first use
+    // after a load; later inserts are merged in on the next call.
+    const SortedIndex& byName() const;
+
+    void displayResumes(int pageSize = 0) const;   // 0 = no paging
+
+    // First resume with this id, nullptr if none.
+    const Resume* searchById(int id) const;
+
+    // Resumes whose skills contain keyword (case-insensitive), in insertion
+    // order. Answered from the skills index; returns the hit count.
+    size_t searchBySkill(const std::string& keyword,
+        std::vector<const Resume*>& out) const;
 
     
+    // Both sorts are stable and compare names case-insensitively.
     void mergeSortByName(bool verbose = false);
+    // Key sort (utils/KeySort): folded name keys radix sorted in parallel,
+    // then the nodes are relinked once. threads: 0 = all cores.
+    void sortByName(unsigned threads = 0);
 
     // utils
     void   clear();
@@ -56,6 +111,34 @@ public:
 
     ResumeLinkedList clone() const;
 
+    // ---- paging ----
+    // Resumable position in list order (head -> tail). A page picks up from a
+    // saved cursor, and cursor(offset) lands on any position in O(1) through
+    // the offset index, so a deep page costs the same as the first one.
+    // Cursors are invalidated by sorts and clear().
+    class Cursor {
+    public:
+        size_t offset() const { return pos; }
+        bool   atEnd() const { return node == nullptr; }
+    private:
+        friend class ResumeLinkedList;
+        const Node* node = nullptr;
+        size_t      pos = 0;
+    };
+
+    Cursor cursor(size_t offset = 0) const;
+
+    // Calls fn on up to n resumes from c and advances c; returns how many.
+    template<typename Fn>
+    size_t page(Cursor& c, size_t n, Fn fn) const {
+        size_t done = 0;
+        for (; c.node && done < n; ++done, ++c.pos) {
+            fn(c.node->data);
+            c.node = c.node->next;
+        }
+        return done;
+    }
+
 private:
     static int  ciCmp(const std::string& a, const std::string& b);
     static char toLowerChar(char c);
@@ -0,0 +1,76 @@
+#include "utils/AhoCorasick.h"
+#include <cctype>
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& pats, bool foldCase)
+    : patterns(pats.size()) {
+    // ---- byte classes ----
+    for (int b = 0; b < 256; ++b) byteClass[b] = 0;
+    auto fold = [foldCase](unsigned char c) {
+        return foldCase ? (unsigned char)std::tolower(c) : c;
+    };
+    for (const auto& p : pats) {
+        for (unsigned char c : p) {
+            const unsigned char f = fold(c);
+            if (byteClass[f] == 0) byteClass[f] = (std::uint16_t)classes++;
+        }
+    }
+    if (foldCase) {
+        for (int b = 0; b < 256; ++b)
+            byteClass[b] = byteClass[fold((unsigned char)b)];
+    }
+
+    // ---- trie (0 = no edge yet; the root is state 0 and is never a child) ----
+    std::vector<std::vector<std::uint32_t>> own(1);
+    next.assign(classes, 0);
+    for (size_t k = 0; k < pats.size(); ++k) {
+        std::uint32_t s = 0;
+        for (unsigned char c : pats[k]) {
+            const size_t cls = byteClass[c];
+            std::uint32_t& edge = next[(size_t)s * classes + cls];
+            if (edge == 0) {
+                edge = (std::uint32_t)own.size();
+                own.emplace_back();
+                next.resize(next.size() + classes, 0);
+            }
+            s = next[(size_t)s * classes + cls];
+        }
+        if (!pats[k].empty()) own[s].push_back((std::uint32_t)k);
+    }
+    const size_t states = own.size();
+
+    // ---- failure links, completed into DFA transitions (BFS) ----
+    std::vector<std::uint32_t> fail(states, 0), order;
+    order.reserve(states);
+    for (size_t c = 0; c < classes; ++c) {
+        const std::uint32_t t = next[c];
+        if (t) { fail[t] = 0; order.push_back(t); }
+    }
+    for (size_t qi = 0; qi < order.size(); ++qi) {
+        const std::uint32_t s = order[qi];
+        for (size_t c = 0; c < classes; ++c) {
+            std::uint32_t& edge = next[(size_t)s * classes + c];
+            const std::uint32_t viaFail = next[(size_t)fail[s] * classes + c];
+            if (edge) {
+                fail[edge] = viaFail;
+                order.push_back(edge);
+            }
+            else {
+                edge = viaFail;
+            }
+        }
+    }
+
+    // ---- outputs: own patterns + everything reachable through fail ----
+    // BFS order guarantees fail[s] is finished before s.
+    std::vector<std::vector<std::uint32_t>> all(states);
+    for (std::uint32_t s : order) {
+        all[s] = own[s];
+        const auto& inherited = all[fail[s]];
+        all[s].insert(all[s].end(), inherited.begin(), inherited.end());
+    }
+    outBegin.assign(states + 1, 0);
+    for (size_t s = 0; s < states; ++s) {
+        outBegin[s + 1] = outBegin[s] + (std::uint32_t)all[s].size();
+        out.insert(out.end(), all[s].begin(), all[s].end());
+    }
+}
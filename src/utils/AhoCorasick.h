@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Multi-pattern matcher compiled to a dense DFA over byte classes.
+// Bytes that appear in no pattern share class 0; with foldCase, 'A' and 'a'
+// share a class, so the text is matched case-insensitively with no copy.
+// Scanning is one table lookup per byte, independent of the pattern count.
+class AhoCorasick {
+public:
+    explicit AhoCorasick(const std::vector<std::string>& patterns, bool foldCase = true);
+
+    size_t patternCount() const { return patterns; }
+    size_t stateCount() const { return outBegin.size() - 1; }
+
+    // Calls onMatch(patternIndex) for every occurrence ending in [p, p + n).
+    template<typename Fn>
+    void scan(const char* p, size_t n, Fn onMatch) const {
+        std::uint32_t s = 0;
+        for (size_t i = 0; i < n; ++i) {
+            s = next[(size_t)s * classes + byteClass[(unsigned char)p[i]]];
+            for (std::uint32_t o = outBegin[s]; o < outBegin[s + 1]; ++o)
+                onMatch(out[o]);
+        }
+    }
+
+private:
+    std::uint16_t byteClass[256];
+    size_t classes = 1;
+    size_t patterns = 0;
+    std::vector<std::uint32_t> next;       // state * classes + class -> state
+    std::vector<std::uint32_t> outBegin;   // per state, into `out` (size states + 1)
+    std::vector<std::uint32_t> out;        // pattern ids, suffix matches included
+};
@@ -0,0 +1,358 @@
+#include "utils/BatchRunner.h"
+#include "utils/MatchLogic.h"
+#include "utils/PagedResults.h"
+#include "utils/Query.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    std::string ms3(double ms) {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.3f", ms);
+        return buf;
+    }
+
+    // JSON string literal (quotes, backslashes and control bytes escaped).
+    void putString(std::ostream& os, const std::string& s) {
+        os << '"';
+        for (char ch : s) {
+            const unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '"') os << "\\\"";
+            else if (c == '\\') os << "\\\\";
+            else if (c == '\n') os << "\\n";
+            else if (c == '\r') os << "\\r";
+            else if (c == '\t') os << "\\t";
+            else if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof buf, "\\u%04x", c);
+                os << buf;
+            }
+            else os << ch;
+        }
+        os << '"';
+    }
+
+    std::string trim(const std::string& s) {
+        size_t b = 0, e = s.size();
+        while (b < e && std::isspace(static_cast<unsigned char>(s[b]))) ++b;
+        while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1]))) --e;
+        return s.substr(b, e - b);
+    }
+
+    // First word of `s` and the trimmed remainder.
+    void splitWord(const std::string& s, std::string& word, std::string& rest) {
+        const std::string t = trim(s);
+        size_t e = 0;
+        while (e < t.size() && !std::isspace(static_cast<unsigned char>(t[e]))) ++e;
+        word = t.substr(0, e);
+        rest = trim(t.substr(e));
+    }
+
+    // Whole string as a decimal int (ids are ints: anything past INT_MAX
+    // would wrap to another id when narrowed).
+    bool parseNumber(const std::string& s, long& out) {
+        if (s.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        out = std::strtol(s.c_str(), &end, 10);
+        return *end == '\0' && errno != ERANGE && out >= INT_MIN && out <= INT_MAX;
+    }
+
+    struct Context {
+        const BatchRunner::Options& opt;
+        const ResumeLinkedList&     resumes;
+        const JobLinkedList&        jobs;
+        const WeightedIndex&        weighted;
+    };
+
+    // A command appends its result fields (",\"key\":value...") to `f`, or
+    // returns false with a message in `err`.
+    using Handler = bool (*)(const Context&, const std::string&, std::ostream& f, std::string& err);
+
+    template<typename Rec>
+    void putIds(std::ostream& f, const PagedResults<const Rec*>& rows, size_t limit) {
+        const size_t n = limit ? std::min(limit, rows.size()) : rows.size();
+        f << ",\"hits\":" << rows.size() << ",\"ids\":[";
+        for (size_t i = 0; i < n; ++i) f << (i ? "," : "") << rows[i]->id;
+        f << "]";
+    }
+
+    bool cmdSearch(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        std::string target, text;
+        splitWord(args, target, text);
+        Query q;
+        if (target == "resumes") {
+            if (!q.compile(text, Query::Target::Resumes, Query::Skills, err)) return false;
+            PagedResults<const ResumeLinkedList::Resume*> rows;
+            q.run(c.resumes, rows, Query::Order::Key);
+            putIds(f, rows, c.opt.limit);
+        }
+        else if (target == "jobs") {
+            if (!q.compile(text, Query::Target::Jobs, Query::Title | Query::Required, err)) return false;
+            PagedResults<const JobLinkedList::Job*> rows;
+            q.run(c.jobs, rows, Query::Order::Key);
+            putIds(f, rows, c.opt.limit);
+        }
+        else {
+            err = "search needs 'resumes' or 'jobs'";
+            return false;
+        }
+        return true;
+    }
+
+    bool cmdJob(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        long id;
+        if (!parseNumber(args, id)) { err = "job needs a numeric id"; return false; }
+        const JobLinkedList::Job* j = c.jobs.searchById((int)id);
+        f << ",\"found\":" << (j ? "true" : "false");
+        if (j) {
+            f << ",\"id\":" << j->id << ",\"title\":";
+            putString(f, j->title);
+            f << ",\"required\":";
+            putString(f, j->required);
+        }
+        return true;
+    }
+
+    bool cmdResume(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        long id;
+        if (!parseNumber(args, id)) { err = "resume needs a numeric id"; return false; }
+        const ResumeLinkedList::Resume* r = c.resumes.searchById((int)id);
+        f << ",\"found\":" << (r ? "true" : "false");
+        if (r) {
+            f << ",\"id\":" << r->id << ",\"name\":";
+            putString(f, r->name);
+            f << ",\"skills\":";
+            putString(f, r->skills);
+        }
+        return true;
+    }
+
+    // "[k]" argument, default 3; no more than there are jobs to rank
+    bool parseK(const Context& c, const std::string& s, size_t& k, std::string& err) {
+        long v = 3;
+        if (!s.empty() && (!parseNumber(s, v) || v < 0)) { err = "k must be a non-negative number"; return false; }
+        k = std::min((size_t)v, c.jobs.rowCount());
+        return true;
+    }
+
+    bool cmdMatch(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        std::string idText, kText;
+        splitWord(args, idText, kText);
+        long id;
+        size_t k;
+        if (!parseNumber(idText, id)) { err = "match needs a resume id"; return false; }
+        if (!parseK(c, kText, k, err)) return false;
+        const ResumeLinkedList::Resume* r = c.resumes.searchById((int)id);
+        if (!r) { err = "no resume with id " + idText; return false; }
+
+        std::vector<MatchLogic::ScoredJob> top;
+        MatchLogic::topJobsForResume(*r, c.jobs, k, top);
+        f << ",\"resume\":" << r->id << ",\"k\":" << k << ",\"jobs\":[";
+        for (size_t i = 0; i < top.size(); ++i)
+            f << (i ? "," : "") << "{\"id\":" << top[i].job->id << ",\"score\":" << top[i].score << "}";
+        f << "]";
+        return true;
+    }
+
+    bool cmdMatchWeighted(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        std::string idText, kText;
+        splitWord(args, idText, kText);
+        long id;
+        size_t k;
+        if (!parseNumber(idText, id)) { err = "match-weighted needs a resume id"; return false; }
+        if (!parseK(c, kText, k, err)) return false;
+        const ResumeLinkedList::Resume* r = c.resumes.searchById((int)id);
+        if (!r) { err = "no resume with id " + idText; return false; }
+
+        std::vector<MatchLogic::ScoredJob> top;
+        MatchLogic::topJobsWeighted(*r, c.jobs, c.weighted, k, top);
+        f << ",\"resume\":" << r->id << ",\"k\":" << k << ",\"jobs\":[";
+        for (size_t i = 0; i < top.size(); ++i)
+            f << (i ? "," : "") << "{\"id\":" << top[i].job->id << ",\"score\":" << top[i].score << "}";
+        f << "]";
+        return true;
+    }
+
+    bool cmdMatchAll(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        size_t k;
+        if (!parseK(c, args, k, err)) return false;
+        std::vector<MatchLogic::ResumeMatches> results;
+        MatchLogic::matchAllParallel(c.resumes, c.jobs, k, c.opt.threads, results);
+        size_t matched = 0;
+        for (const auto& m : results) if (!m.top.empty()) ++matched;
+        f << ",\"k\":" << k << ",\"resumes\":" << results.size() << ",\"matched\":" << matched;
+        return true;
+    }
+
+    bool cmdSort(const Context& c, const std::string& args, std::ostream& f, std::string& err) {
+        std::string target, algo;
+        splitWord(args, target, algo);
+        if (target != "resumes") { err = "only 'sort resumes' is supported"; return false; }
+        if (algo.empty()) algo = "merge";
+        if (algo != "merge" && algo != "keys") { err = "sort algorithm is 'merge' or 'keys'"; return false; }
+
+        ResumeLinkedList copy = c.resumes.clone();
+        const auto t0 = Clock::now();
+        if (algo == "merge") copy.mergeSortByName();
+        else copy.sortByName(c.opt.threads);
+        const double sortMs = msSince(t0);
+
+        f << ",\"algorithm\":\"" << algo << "\",\"sort_ms\":" << ms3(sortMs) << ",\"first\":[";
+        const size_t n = c.opt.limit ? c.opt.limit : copy.size();
+        ResumeLinkedList::Cursor at = copy.cursor();
+        size_t i = 0;
+        copy.page(at, n, [&](const ResumeLinkedList::Resume& r) {
+            if (i++) f << ",";
+            putString(f, r.name);
+        });
+        f << "]";
+        return true;
+    }
+
+    struct Command {
+        const char* name;
+        Handler     run;
+    };
+
+    const Command kCommands[] = {
+        { "search", cmdSearch },
+        { "job", cmdJob },
+        { "resume", cmdResume },
+        { "match", cmdMatch },
+        { "match-weighted", cmdMatchWeighted },
+        { "match-all", cmdMatchAll },
+        { "sort", cmdSort },
+    };
+
+    const char* const kUsage =
+        "usage: JobMatchingDSA --batch <commands.txt|-> [--out results.jsonl] [--limit N]\n"
+        "                      [--threads N] [--resumes csv] [--jobs csv] [--snapshot file]\n";
+
+} // namespace
+
+bool BatchRunner::parseDataOption(const std::string& name, const std::string& value, Options& opt) {
+    long n = 0;
+    if (name == "--limit" && parseNumber(value, n) && n >= 0) opt.limit = (size_t)n;
+    else if (name == "--threads" && parseNumber(value, n) && n >= 0) opt.threads = (unsigned)n;
+    else if (name == "--resumes") opt.resumesCsv = value;
+    else if (name == "--jobs") opt.jobsCsv = value;
+    else if (name == "--snapshot") opt.snapshot = value;
+    else return false;
+    return true;
+}
+
+bool BatchRunner::parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n" << kUsage; return false; }
+        const std::string v = argv[++i];
+        if (a == "--batch") opt.commands = v;
+        else if (a == "--out") opt.out = v;
+        else if (!parseDataOption(a, v, opt)) { std::cerr << "bad option " << a << " " << v << "\n" << kUsage; return false; }
+    }
+    if (opt.commands.empty()) { std::cerr << kUsage; return false; }
+    return true;
+}
+
+Snapshot::LoadResult BatchRunner::load(const Options& opt, Dataset& data) {
+    const Snapshot::LoadResult r = Snapshot::loadOrParse(opt.snapshot, opt.resumesCsv, opt.jobsCsv,
+        data.resumes, data.jobs, opt.threads);
+    data.resumes.byName();
+    data.jobs.byTitle();
+    data.weighted.build(data.resumes, data.jobs);
+    return r;
+}
+
+bool BatchRunner::execute(const Options& opt, const Dataset& data, const std::string& text,
+    std::ostream& fields) {
+    std::string name, args;
+    splitWord(text, name, args);
+    const Command* cmd = nullptr;
+    for (const Command& c : kCommands)
+        if (name == c.name) cmd = &c;
+
+    const Context ctx{ opt, data.resumes, data.jobs, data.weighted };
+    std::ostringstream result;
+    std::string err;
+    const auto t0 = Clock::now();
+    bool ok = false;
+    if (cmd) ok = cmd->run(ctx, args, result, err);
+    else err = "unknown command";
+    const double ms = msSince(t0);
+
+    fields << "\"cmd\":";
+    putString(fields, name);
+    fields << ",\"args\":";
+    putString(fields, args);
+    fields << ",\"ok\":" << (ok ? "true" : "false") << ",\"ms\":" << ms3(ms);
+    if (ok) fields << result.str();
+    else { fields << ",\"error\":"; putString(fields, err); }
+    return ok;
+}
+
+int BatchRunner::run(const Options& opt) {
+    std::ifstream commandFile;
+    std::istream* in = &std::cin;
+    if (opt.commands != "-") {
+        commandFile.open(opt.commands);
+        if (!commandFile.is_open()) { std::cerr << "[batch] cannot open " << opt.commands << "\n"; return 1; }
+        in = &commandFile;
+    }
+    std::ofstream outFile;
+    std::ostream* out = &std::cout;
+    if (!opt.out.empty()) {
+        outFile.open(opt.out);
+        if (!outFile.is_open()) { std::cerr << "[batch] cannot write " << opt.out << "\n"; return 1; }
+        out = &outFile;
+    }
+
+    // ---- data, once ----
+    Dataset data;
+    const auto t0 = Clock::now();
+    const Snapshot::LoadResult loaded = load(opt, data);
+    *out << "{\"line\":0,\"cmd\":\"load\",\"ok\":" << (loaded.ok ? "true" : "false")
+        << ",\"ms\":" << ms3(msSince(t0)) << ",\"resumes\":" << data.resumes.size()
+        << ",\"jobs\":" << data.jobs.rowCount()
+        << ",\"from_snapshot\":" << (loaded.fromSnapshot ? "true" : "false") << "}\n" << std::flush;
+    if (!loaded.ok) return 1;
+
+    // ---- commands ----
+    size_t lineNo = 0, ran = 0, failed = 0;
+    std::string line;
+    const auto start = Clock::now();
+    while (std::getline(*in, line)) {
+        ++lineNo;
+        const std::string text = trim(line);
+        if (text.empty() || text[0] == '#') continue;
+
+        std::ostringstream row;
+        row << "{\"line\":" << lineNo << ",";
+        if (!execute(opt, data, text, row)) ++failed;
+        ++ran;
+        row << "}\n";
+        *out << row.str() << std::flush;
+    }
+
+    const double totalMs = msSince(start);
+    *out << "{\"cmd\":\"summary\",\"commands\":" << ran << ",\"failed\":" << failed
+        << ",\"total_ms\":" << ms3(totalMs)
+        << ",\"per_second\":" << ms3(totalMs > 0 ? ran * 1000.0 / totalMs : 0.0) << "}\n" << std::flush;
+    return failed ? 2 : 0;
+}
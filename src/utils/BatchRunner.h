@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include "io/Snapshot.h"
+#include "models/JobLinkedList.h"
+#include "models/ResumeLinkedList.h"
+#include "utils/WeightedIndex.h"
+
+// Headless entry point: loads the dataset once, runs a file of commands back
+// to back with no prompts, and writes one JSON line per command with its
+// wall time, plus a closing summary line. Started as
+//
+//     JobMatchingDSA --batch commands.txt [--out results.jsonl] [--limit N] [--threads N]
+//
+// One command per line; blank lines and lines starting with '#' are skipped:
+//
+//     search resumes <query>     resumes matching a query (option 3), name order
+//     search jobs <query>        jobs matching a query (option 7), title order
+//     job <id>                   job by id
+//     resume <id>                resume by id
+//     match <resumeId> [k]       top-k jobs for one resume (option 4, k = 3)
+//     match-weighted <id> [k]    same by TF-IDF cosine (option 13)
+//     match-all [k]              top-k jobs for every resume (option 10)
+//     sort resumes [merge|keys]  sort a copy of the resumes by name (option 8)
+//
+// Queries use the menu's query language (utils/Query.h). The same commands
+// are answered over a socket by utils/MatchServer.
+namespace BatchRunner {
+
+    struct Options {
+        std::string commands;      // command file, "-" = stdin
+        std::string out;           // JSONL file, empty = stdout
+        std::string resumesCsv = "data/resume.csv";
+        std::string jobsCsv = "data/job_description.csv";
+        std::string snapshot = "data/dataset.snap";
+        size_t   limit = 10;       // ids listed per result, 0 = all
+        unsigned threads = 0;      // 0 = all cores
+    };
+
+    // Parses the arguments after the program name; false (with a message on
+    // stderr) when they are malformed or --batch is missing.
+    bool parseArgs(int argc, char** argv, Options& opt);
+    // Applies one data / output option (--limit, --threads, --resumes, --jobs,
+    // --snapshot); false when `name` is not one of them or `value` is bad.
+    bool parseDataOption(const std::string& name, const std::string& value, Options& opt);
+
+    // The loaded lists. Commands only read them (the sorted indexes are
+    // settled and the TF-IDF index built by load()), so any number of
+    // threads may run commands at once.
+    struct Dataset {
+        ResumeLinkedList resumes;
+        JobLinkedList    jobs;
+        WeightedIndex    weighted;
+    };
+
+    // Snapshot or CSVs, as menu option 1.
+    Snapshot::LoadResult load(const Options& opt, Dataset& data);
+
+    // Runs one command line and writes its JSON fields without the braces
+    // ("cmd", "args", "ok", "ms", then the results or "error"). Returns ok.
+    bool execute(const Options& opt, const Dataset& data, const std::string& text,
+        std::ostream& fields);
+
+    // Process exit code: 0 when every command ran, 1 when the data or a file
+    // could not be opened, 2 when some command failed.
+    int run(const Options& opt);
+
+} // namespace BatchRunner
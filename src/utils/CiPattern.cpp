@@ -0,0 +1,64 @@
+#include "utils/CiPattern.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CIPATTERN_SSE2 1
+#endif
+
+#if defined(CIPATTERN_SSE2)
+static inline unsigned firstBit(unsigned m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i; _BitScanForward(&i, m); return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctz(m);
+#endif
+}
+
+// 'A'..'Z' -> 'a'..'z' for 16 bytes: shift the range to the bottom of the
+// signed byte range so one compare finds the upper-case letters.
+static inline __m128i foldAscii(__m128i v) {
+    const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    const __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+CiPattern::CiPattern(const std::string& pattern) : pat(pattern) {
+    for (char& c : pat) c = fold(c);
+}
+
+// Bytes 1 .. size-2 of a candidate whose first and last bytes already match.
+bool CiPattern::middleMatches(const char* at) const {
+    for (size_t j = 1; j + 1 < pat.size(); ++j)
+        if (fold(at[j]) != pat[j]) return false;
+    return true;
+}
+
+bool CiPattern::foundIn(const char* text, size_t n) const {
+    const size_t m = pat.size();
+    if (m == 0) return true;
+    if (n < m) return false;
+
+    const size_t last = n - m;   // last possible start
+    size_t i = 0;
+#if defined(CIPATTERN_SSE2)
+    const __m128i first = _mm_set1_epi8(pat[0]);
+    const __m128i lastByte = _mm_set1_epi8(pat[m - 1]);
+    for (; i + 16 <= last + 1; i += 16) {
+        const __m128i a = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+        const __m128i b = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + m - 1)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, lastByte)));
+        while (mask) {
+            if (middleMatches(text + i + firstBit(mask))) return true;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i <= last; ++i) {
+        if (fold(text[i]) == pat[0] && fold(text[i + m - 1]) == pat[m - 1] &&
+            middleMatches(text + i))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Case-insensitive substring pattern, folded and prepared once per query so
+// each row can be scanned in place without allocating.
+//
+// Folding is ASCII only (A-Z -> a-z), the same as std::tolower in the
+// default "C" locale. With SSE2 the scan compares the pattern's first and
+// last folded bytes against 16 text positions at a time and only checks the
+// bytes in between for the positions where both match.
+class CiPattern {
+public:
+    CiPattern() = default;
+    explicit CiPattern(const std::string& pattern);
+
+    // Folded pattern text.
+    const std::string& folded() const { return pat; }
+    bool empty() const { return pat.empty(); }
+
+    // True when the pattern occurs in text[0, n). An empty pattern matches.
+    bool foundIn(const char* text, size_t n) const;
+    bool foundIn(const std::string& text) const { return foundIn(text.data(), text.size()); }
+
+    static char fold(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+
+private:
+    bool middleMatches(const char* at) const;
+
+    std::string pat;
+};
@@ -0,0 +1,201 @@
+#include "utils/DenseEmbedding.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    // Job panels scored per pass over a resume range: about 128 KB of
+    // panels, so a block stays in L2 while the resumes stream past it.
+    const size_t kBlockBytes = 128 * 1024;
+    const size_t kTileRows = 4;
+
+    inline std::uint64_t splitmix64(std::uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+    // a * b + c; fused when the target has FMA (MSVC /arch:AVX2 may not say so)
+    inline __m256 madd(__m256 a, __m256 b, __m256 c) {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+#endif
+
+    // out[i][l] = dot(rows[i], job l of the panel), 4 resumes x 16 jobs.
+    void scoreTile(const float* const* rows, const float* panel, size_t width,
+        float out[kTileRows][DenseEmbedding::kPanel]) {
+        const size_t P = DenseEmbedding::kPanel;
+#if defined(__AVX512F__)
+        __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+        __m512 a2 = _mm512_setzero_ps(), a3 = _mm512_setzero_ps();
+        for (size_t d = 0; d < width; ++d) {
+            const __m512 b = _mm512_loadu_ps(panel + d * P);
+            a0 = _mm512_fmadd_ps(_mm512_set1_ps(rows[0][d]), b, a0);
+            a1 = _mm512_fmadd_ps(_mm512_set1_ps(rows[1][d]), b, a1);
+            a2 = _mm512_fmadd_ps(_mm512_set1_ps(rows[2][d]), b, a2);
+            a3 = _mm512_fmadd_ps(_mm512_set1_ps(rows[3][d]), b, a3);
+        }
+        _mm512_storeu_ps(out[0], a0);
+        _mm512_storeu_ps(out[1], a1);
+        _mm512_storeu_ps(out[2], a2);
+        _mm512_storeu_ps(out[3], a3);
+#elif defined(__AVX2__)
+        // eight named accumulators: an indexed array of them gets spilled
+        __m256 a00 = _mm256_setzero_ps(), a01 = _mm256_setzero_ps();
+        __m256 a10 = _mm256_setzero_ps(), a11 = _mm256_setzero_ps();
+        __m256 a20 = _mm256_setzero_ps(), a21 = _mm256_setzero_ps();
+        __m256 a30 = _mm256_setzero_ps(), a31 = _mm256_setzero_ps();
+        for (size_t d = 0; d < width; ++d) {
+            const __m256 b0 = _mm256_loadu_ps(panel + d * P);
+            const __m256 b1 = _mm256_loadu_ps(panel + d * P + 8);
+            __m256 x = _mm256_set1_ps(rows[0][d]);
+            a00 = madd(x, b0, a00); a01 = madd(x, b1, a01);
+            x = _mm256_set1_ps(rows[1][d]);
+            a10 = madd(x, b0, a10); a11 = madd(x, b1, a11);
+            x = _mm256_set1_ps(rows[2][d]);
+            a20 = madd(x, b0, a20); a21 = madd(x, b1, a21);
+            x = _mm256_set1_ps(rows[3][d]);
+            a30 = madd(x, b0, a30); a31 = madd(x, b1, a31);
+        }
+        _mm256_storeu_ps(out[0], a00); _mm256_storeu_ps(out[0] + 8, a01);
+        _mm256_storeu_ps(out[1], a10); _mm256_storeu_ps(out[1] + 8, a11);
+        _mm256_storeu_ps(out[2], a20); _mm256_storeu_ps(out[2] + 8, a21);
+        _mm256_storeu_ps(out[3], a30); _mm256_storeu_ps(out[3] + 8, a31);
+#else
+        for (size_t i = 0; i < kTileRows; ++i)
+            for (size_t l = 0; l < P; ++l) out[i][l] = 0.0f;
+        for (size_t d = 0; d < width; ++d) {
+            const float* b = panel + d * P;
+            for (size_t i = 0; i < kTileRows; ++i) {
+                const float a = rows[i][d];
+                for (size_t l = 0; l < P; ++l) out[i][l] += a * b[l];
+            }
+        }
+#endif
+    }
+
+    // Bit l set when s[l] > threshold, for the 16 scores of one tile row.
+    unsigned aboveMask(const float* s, float threshold) {
+#if defined(__AVX512F__)
+        return _mm512_cmp_ps_mask(_mm512_loadu_ps(s), _mm512_set1_ps(threshold), _CMP_GT_OQ);
+#elif defined(__AVX2__)
+        const __m256 t = _mm256_set1_ps(threshold);
+        const unsigned lo = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(s), t, _CMP_GT_OQ));
+        const unsigned hi = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(s + 8), t, _CMP_GT_OQ));
+        return lo | (hi << 8);
+#else
+        unsigned m = 0;
+        for (size_t l = 0; l < DenseEmbedding::kPanel; ++l)
+            if (s[l] > threshold) m |= 1u << l;
+        return m;
+#endif
+    }
+
+} // namespace
+
+constexpr size_t DenseEmbedding::kPanel;   // odr-used by std::min below
+
+const char* DenseEmbedding::kernelName() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+DenseEmbedding::DenseEmbedding(size_t dims) : width(dims ? dims : 1) {}
+
+void DenseEmbedding::clear() {
+    resumes = jobs = 0;
+    resumeRows.clear();
+    jobPanels.clear();
+}
+
+void DenseEmbedding::embed(const WeightedIndex::Vector& v, float* out) const {
+    std::fill(out, out + width, 0.0f);
+    // terms are dense ids, so the slot is the id folded into the width: no
+    // two phrases collide until there are more phrases than slots, and past
+    // that the hashed sign keeps colliding weights from adding up on average
+    for (size_t i = 0; i < v.size; ++i) {
+        const float w = (splitmix64(v.terms[i]) >> 63) ? -v.weights[i] : v.weights[i];
+        out[v.terms[i] % width] += w;
+    }
+    // colliding phrases change the length
+    double norm = 0;
+    for (size_t d = 0; d < width; ++d) norm += (double)out[d] * out[d];
+    if (norm <= 0) return;
+    const float inv = (float)(1.0 / std::sqrt(norm));
+    for (size_t d = 0; d < width; ++d) out[d] *= inv;
+}
+
+void DenseEmbedding::build(const WeightedIndex& index) {
+    resumes = index.resumeCount();
+    jobs = index.jobCount();
+
+    resumeRows.assign(resumes * width, 0.0f);
+    for (size_t r = 0; r < resumes; ++r)
+        embed(index.resumeVector(r), resumeRows.data() + r * width);
+
+    // panel p holds jobs [p * kPanel, p * kPanel + kPanel) transposed
+    const size_t panels = (jobs + kPanel - 1) / kPanel;
+    jobPanels.assign(panels * width * kPanel, 0.0f);
+    std::vector<float> row(width);
+    for (size_t j = 0; j < jobs; ++j) {
+        embed(index.jobVector(j), row.data());
+        float* panel = jobPanels.data() + (j / kPanel) * width * kPanel;
+        for (size_t d = 0; d < width; ++d) panel[d * kPanel + j % kPanel] = row[d];
+    }
+}
+
+void DenseEmbedding::topJobs(size_t begin, size_t end, size_t k,
+    std::vector<std::vector<Hit>>& out) const {
+    end = std::min(end, resumes);
+    out.assign(end > begin ? end - begin : 0, std::vector<Hit>());
+    if (k == 0 || out.empty()) return;
+
+    const size_t panels = (jobs + kPanel - 1) / kPanel;
+    const size_t panelBytes = width * kPanel * sizeof(float);
+    const size_t block = std::max<size_t>(1, kBlockBytes / panelBytes);
+
+    std::vector<TopK<float, Row>> best(out.size(), TopK<float, Row>(k));
+    const std::vector<float> zeros(width, 0.0f);   // stands in for missing tile rows
+    float tile[kTileRows][kPanel];
+
+    for (size_t pb = 0; pb < panels; pb += block) {
+        const size_t pe = std::min(panels, pb + block);
+        for (size_t r = begin; r < end; r += kTileRows) {
+            const size_t rn = std::min(kTileRows, end - r);
+            const float* rows[kTileRows];
+            for (size_t i = 0; i < kTileRows; ++i)
+                rows[i] = i < rn ? resumeRow(r + i) : zeros.data();
+
+            for (size_t p = pb; p < pe; ++p) {
+                scoreTile(rows, jobPanels.data() + p * width * kPanel, width, tile);
+                const size_t j0 = p * kPanel;
+                const size_t jn = std::min(kPanel, jobs - j0);
+                const unsigned lanes = jn == kPanel ? ~0u : (1u << jn) - 1;
+                for (size_t i = 0; i < rn; ++i) {
+                    TopK<float, Row>& b = best[r + i - begin];
+                    // jobs arrive in row order, so a tie with the weakest kept
+                    // score never wins; most tiles have no lane above it
+                    unsigned m = aboveMask(tile[i], b.full() ? b.weakest().score : 0.0f) & lanes;
+                    for (size_t l = 0; m; ++l, m >>= 1)
+                        if (m & 1u) b.offer(tile[i][l], (Row)(j0 + l));
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < best.size(); ++i) best[i].take(out[i]);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/TopK.h"
+#include "utils/WeightedIndex.h"
+
+// Fixed-width float embeddings of the TF-IDF vectors, for all-pairs runs.
+//
+// build() feature-hashes every resume and job vector of a WeightedIndex into
+// `dims` floats (each phrase adds its weight, with a hashed sign, to slot
+// term % dims) and re-normalizes them. While the phrases fit in `dims`
+// slots a dot product is exactly the TF-IDF cosine; past that, colliding
+// phrases make it an estimate.
+//
+// Jobs are packed into panels of kPanel jobs stored dimension-major, so the
+// kernel reads one panel row as a vector and multiplies it by a broadcast
+// resume value: a 4 x 16 tile of scores per step with no horizontal sums
+// (AVX-512, AVX2 or scalar, picked at compile time). Panels are walked in
+// cache-sized blocks per group of resumes, and each tile is fed straight to
+// the resumes' bounded top-K heaps, so the R x J score matrix never exists.
+class DenseEmbedding {
+public:
+    using Row = std::uint32_t;
+    using Hit = TopK<float, Row>::Entry;
+
+    static constexpr size_t kPanel = 16;   // jobs per packed panel
+
+    explicit DenseEmbedding(size_t dims = 128);
+
+    // Embeds every resume and job of `index` (rows = index rows).
+    void build(const WeightedIndex& index);
+    void clear();
+
+    size_t dims() const { return width; }
+    size_t resumeCount() const { return resumes; }
+    size_t jobCount() const { return jobs; }
+    const float* resumeRow(size_t row) const { return resumeRows.data() + row * width; }
+
+    // Best k job rows for each resume in [begin, end), out[r - begin] best
+    // first; ties go to the smaller job row and only positive scores count.
+    void topJobs(size_t begin, size_t end, size_t k, std::vector<std::vector<Hit>>& out) const;
+
+    // "avx512", "avx2" or "scalar": the kernel this build uses.
+    static const char* kernelName();
+
+private:
+    void embed(const WeightedIndex::Vector& v, float* out) const;
+
+    size_t width;
+    size_t resumes = 0;
+    size_t jobs = 0;
+    std::vector<float> resumeRows;   // resumes x width, row-major
+    std::vector<float> jobPanels;    // panel p: width x kPanel, zero-padded past the last job
+};
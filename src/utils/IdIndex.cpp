@@ -0,0 +1,56 @@
+#include "utils/IdIndex.h"
+
+const IdIndex::Slot IdIndex::kEmpty;
+
+// Grow the direct table while an id is within twice the current population
+// (plus some slack), so a few outliers cannot blow up memory.
+bool IdIndex::fitsDirect(int id) const {
+    if (id < 0) return false;
+    const size_t limit = 2 * count + 1024;
+    return (size_t)id < direct.size() || (size_t)id <= limit;
+}
+
+bool IdIndex::insert(int id, Slot slot) {
+    if (contains(id)) return false;
+    assign(id, slot);
+    return true;
+}
+
+void IdIndex::assign(int id, Slot slot) {
+    // an id parked in the hash map before the table grew over it stays there
+    if (!sparse.empty()) {
+        auto it = sparse.find(id);
+        if (it != sparse.end()) { it->second = slot; return; }
+    }
+    if (fitsDirect(id)) {
+        if ((size_t)id >= direct.size()) {
+            size_t n = direct.empty() ? 1024 : direct.size();
+            while (n <= (size_t)id) n *= 2;
+            direct.resize(n, kEmpty);
+        }
+        if (direct[id] == kEmpty) ++count;
+        direct[id] = slot;
+        return;
+    }
+    auto res = sparse.emplace(id, slot);
+    if (res.second) ++count;
+    else res.first->second = slot;
+}
+
+bool IdIndex::find(int id, Slot& slot) const {
+    if (id >= 0 && (size_t)id < direct.size() && direct[id] != kEmpty) {
+        slot = direct[id];
+        return true;
+    }
+    if (sparse.empty()) return false;
+    auto it = sparse.find(id);
+    if (it == sparse.end()) return false;
+    slot = it->second;
+    return true;
+}
+
+void IdIndex::clear() {
+    direct.clear();
+    sparse.clear();
+    count = 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// id -> slot map for record containers. Ids that stay reasonably dense
+// (the loaders hand out 1..N) go into a direct-address table; anything far
+// outside it falls back to a hash map, so both cases are O(1).
+class IdIndex {
+public:
+    using Slot = std::uint32_t;
+
+    // Adds id -> slot; returns false (and keeps the old slot) on a duplicate.
+    bool insert(int id, Slot slot);
+    // Overwrites the slot of an existing or new id (used after re-layouts).
+    void assign(int id, Slot slot);
+    bool find(int id, Slot& slot) const;
+    bool contains(int id) const { Slot s; return find(id, s); }
+
+    void clear();
+    size_t size() const { return count; }
+
+private:
+    static const Slot kEmpty = 0xFFFFFFFFu;
+    bool fitsDirect(int id) const;
+
+    std::vector<Slot> direct;                 // index = id
+    std::unordered_map<int, Slot> sparse;
+    size_t count = 0;
+};
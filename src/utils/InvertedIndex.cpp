@@ -0,0 +1,159 @@
+#include "utils/InvertedIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+// ---- helpers ----
+static bool isTokenChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0;
+}
+
+static char toLowerChar(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+// 1 to 3 bytes and their count in one key.
+static std::uint32_t packGram(const char* s, size_t len) {
+    std::uint32_t key = static_cast<std::uint32_t>(len) << 24;
+    for (size_t i = 0; i < len; ++i)
+        key |= static_cast<std::uint32_t>(static_cast<unsigned char>(s[i])) << (8 * i);
+    return key;
+}
+
+// ---- build ----
+void InvertedIndex::tokenize(const std::string& text, std::vector<std::string>& out) {
+    out.clear();
+    std::string cur;
+    for (char c : text) {
+        if (isTokenChar(c)) {
+            cur.push_back(toLowerChar(c));
+        }
+        else if (!cur.empty()) {
+            out.push_back(cur);
+            cur.clear();
+        }
+    }
+    if (!cur.empty()) out.push_back(cur);
+}
+
+InvertedIndex::TokenNo InvertedIndex::tokenNo(const std::string& token) {
+    auto ins = ids.emplace(token, static_cast<TokenNo>(tokens.size()));
+    if (!ins.second) return ins.first->second;
+    const TokenNo no = ins.first->second;
+    tokens.push_back(token);
+    lists.emplace_back();
+
+    // every distinct 1-3 character substring, once (numbers only grow, so
+    // each gram's token list stays ascending)
+    std::vector<std::uint32_t> keys;
+    for (size_t len = 1; len <= 3; ++len)
+        for (size_t i = 0; i + len <= token.size(); ++i)
+            keys.push_back(packGram(token.data() + i, len));
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (std::uint32_t key : keys) grams[key].push_back(no);
+    return no;
+}
+
+void InvertedIndex::add(Row row, const std::string& text) {
+    std::vector<std::string> words;
+    tokenize(text, words);
+    for (const auto& t : words) {
+        Postings& p = lists[tokenNo(t)];
+        if (p.empty() || p.back() != row) p.push_back(row);
+    }
+    if (row + 1 > rows) rows = row + 1;
+}
+
+void InvertedIndex::reserve(size_t count) {
+    ids.reserve(count);
+    tokens.reserve(count);
+    lists.reserve(count);
+}
+
+void InvertedIndex::assign(const std::string& token, Postings&& list) {
+    lists[tokenNo(token)] = std::move(list);
+}
+
+void InvertedIndex::clear() {
+    ids.clear();
+    tokens.clear();
+    lists.clear();
+    grams.clear();
+    rows = 0;
+}
+
+// ---- lookup ----
+const InvertedIndex::Postings* InvertedIndex::find(const std::string& token) const {
+    auto it = ids.find(token);
+    return it == ids.end() ? nullptr : &lists[it->second];
+}
+
+const std::vector<InvertedIndex::TokenNo>* InvertedIndex::tokensWith(const char* gram, size_t len) const {
+    auto it = grams.find(packGram(gram, len));
+    return it == grams.end() ? nullptr : &it->second;
+}
+
+// Union of the posting lists of every indexed token that contains `part`.
+// Only tokens sharing the part's rarest trigram are visited, so cost tracks
+// those tokens + hits, not the vocabulary.
+void InvertedIndex::unionContaining(const std::string& part, Postings& out) const {
+    out.clear();
+    if (part.empty()) return;
+
+    const std::vector<TokenNo>* with = nullptr;
+    if (part.size() <= 3) {
+        with = tokensWith(part.data(), part.size());   // exact: holding it is containing it
+    }
+    else {
+        for (size_t i = 0; i + 3 <= part.size(); ++i) {
+            const std::vector<TokenNo>* g = tokensWith(part.data() + i, 3);
+            if (!g) return;   // some trigram is in no token
+            if (!with || g->size() < with->size()) with = g;
+        }
+    }
+    if (!with) return;
+
+    const Postings* single = nullptr;
+    size_t found = 0;
+    for (TokenNo t : *with) {
+        if (part.size() > 3 && tokens[t].find(part) == std::string::npos) continue;
+        ++found;
+        if (found == 1) { single = &lists[t]; continue; }
+        if (found == 2) out.assign(single->begin(), single->end());
+        out.insert(out.end(), lists[t].begin(), lists[t].end());
+    }
+    if (found == 1) { out = *single; return; }
+    if (found > 1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+bool InvertedIndex::candidates(const std::string& keyword, Postings& out) const {
+    out.clear();
+
+    std::vector<std::string> parts;
+    tokenize(keyword, parts);
+
+    // Nothing to look up: every row is a candidate (matches std::string::find("")).
+    if (parts.empty()) {
+        out.reserve(rows);
+        for (size_t r = 0; r < rows; ++r) out.push_back(static_cast<Row>(r));
+        return keyword.empty();
+    }
+
+    // Every alnum run of the keyword must sit inside some token of the row.
+    unionContaining(parts[0], out);
+    Postings next, merged;
+    for (size_t i = 1; i < parts.size() && !out.empty(); ++i) {
+        unionContaining(parts[i], next);
+        merged.clear();
+        std::set_intersection(out.begin(), out.end(), next.begin(), next.end(),
+            std::back_inserter(merged));
+        out.swap(merged);
+    }
+
+    // A single bare token is answered exactly by the vocabulary lookup.
+    return parts.size() == 1 && parts[0].size() == keyword.size();
+}
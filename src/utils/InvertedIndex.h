@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Token -> posting list index used by the keyword searches.
+// Rows are caller-defined ordinals and must be added in ascending order,
+// so every posting list stays sorted without extra work.
+//
+// Keywords match inside tokens ("sql" finds "mysql"), so the vocabulary is
+// indexed too: every 1-, 2- and 3-character substring of a token lists the
+// tokens containing it. A keyword part of up to three characters is one
+// lookup; a longer one checks only the tokens holding its rarest trigram.
+class InvertedIndex {
+public:
+    using Row = std::uint32_t;
+    using Postings = std::vector<Row>;
+
+    // Tokenize `text` (lower-cased alnum runs) and append `row` to each token.
+    void add(Row row, const std::string& text);
+    void clear();
+
+    size_t rowCount() const { return rows; }
+    size_t tokenCount() const { return tokens.size(); }
+
+    // Exact-token lookup (token must already be lower-case); nullptr if absent.
+    const Postings* find(const std::string& token) const;
+
+    // Collects, ascending, every row whose text may contain `keyword`
+    // case-insensitively. Returns true when the result is exact, false when
+    // the caller still has to confirm each candidate against the text.
+    bool candidates(const std::string& keyword, Postings& out) const;
+
+    // Splits into lower-cased alnum runs (the same tokens add() indexes).
+    static void tokenize(const std::string& text, std::vector<std::string>& out);
+
+    // Bulk access for persistence: visit every (token, rows) list, or install
+    // one directly (rows ascending) and set the row count afterwards.
+    template<typename Fn>
+    void forEachList(Fn fn) const {
+        for (size_t t = 0; t < tokens.size(); ++t) fn(tokens[t], lists[t]);
+    }
+    void reserve(size_t count);
+    void assign(const std::string& token, Postings&& list);
+    void setRowCount(size_t n) { rows = n; }
+
+private:
+    using TokenNo = std::uint32_t;
+
+    // Number of `token`, adding it (and its substrings to `grams`) if new.
+    TokenNo tokenNo(const std::string& token);
+    // Tokens containing `gram` (1 to 3 characters), ascending; nullptr if none.
+    const std::vector<TokenNo>* tokensWith(const char* gram, size_t len) const;
+    void unionContaining(const std::string& part, Postings& out) const;
+
+    std::unordered_map<std::string, TokenNo> ids;
+    std::vector<std::string> tokens;    // by number
+    std::vector<Postings>    lists;     // by number
+    std::unordered_map<std::uint32_t, std::vector<TokenNo>> grams;   // packed substring -> tokens
+    size_t rows = 0;
+};
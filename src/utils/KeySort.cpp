@@ -0,0 +1,149 @@
+#include "utils/KeySort.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+    struct Item {
+        std::uint64_t key;
+        std::uint32_t idx;
+    };
+
+    // Below this many items a single thread is faster than the pool.
+    const size_t kParallelMin = 1u << 16;
+    // Tied runs up to this size are finished with a comparison sort.
+    const size_t kSmallRun = 64;
+
+    inline unsigned char foldByte(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    }
+
+    // Bytes [off, off + 8) of s, big-endian, zero padded past the end.
+    inline std::uint64_t chunkKey(const TextView& s, size_t off, bool fold) {
+        std::uint64_t k = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            unsigned char c = 0;
+            if (off + i < s.size) {
+                c = static_cast<unsigned char>(s.data[off + i]);
+                if (fold) c = foldByte(c);
+            }
+            k = (k << 8) | c;
+        }
+        return k;
+    }
+
+    inline bool keyLess(const Item& a, const Item& b) { return a.key < b.key; }
+
+    // Stable LSD radix sort of a[0, n) on the full 64-bit key, one byte per
+    // pass; passes where every key has the same byte are skipped.
+    void radixSort(Item* a, Item* tmp, size_t n, ThreadPool* pool) {
+        const size_t chunks = (pool && n >= kParallelMin) ? pool->size() : 1;
+        const size_t per = (n + chunks - 1) / chunks;
+        std::vector<size_t> hist(chunks * 256);
+
+        Item* src = a;
+        Item* dst = tmp;
+        for (unsigned pass = 0; pass < 8; ++pass) {
+            const unsigned shift = pass * 8;
+            std::fill(hist.begin(), hist.end(), 0);
+
+            auto count = [&](size_t c) {
+                size_t* h = &hist[c * 256];
+                const size_t b = c * per, e = std::min(n, b + per);
+                for (size_t i = b; i < e; ++i) ++h[(src[i].key >> shift) & 0xFF];
+            };
+            if (chunks > 1) pool->parallelFor(chunks, 1, [&](size_t b, size_t e) { for (size_t c = b; c < e; ++c) count(c); });
+            else count(0);
+
+            // exclusive prefix over (digit, chunk) keeps chunks in input order
+            size_t sum = 0;
+            bool trivial = false;
+            for (size_t d = 0; d < 256; ++d) {
+                size_t digitTotal = 0;
+                for (size_t c = 0; c < chunks; ++c) {
+                    const size_t v = hist[c * 256 + d];
+                    hist[c * 256 + d] = sum;
+                    sum += v;
+                    digitTotal += v;
+                }
+                if (digitTotal == n) trivial = true;
+            }
+            if (trivial) continue;
+
+            auto scatter = [&](size_t c) {
+                size_t* h = &hist[c * 256];
+                const size_t b = c * per, e = std::min(n, b + per);
+                for (size_t i = b; i < e; ++i) dst[h[(src[i].key >> shift) & 0xFF]++] = src[i];
+            };
+            if (chunks > 1) pool->parallelFor(chunks, 1, [&](size_t b, size_t e) { for (size_t c = b; c < e; ++c) scatter(c); });
+            else scatter(0);
+            std::swap(src, dst);
+        }
+        if (src != a) std::copy(src, src + n, a);
+    }
+
+    void sortRun(Item* a, Item* tmp, size_t n, ThreadPool* pool) {
+        if (n <= kSmallRun) std::stable_sort(a, a + n, keyLess);
+        else radixSort(a, tmp, n, pool);
+    }
+
+} // namespace
+
+namespace keysort {
+
+    void order(const std::vector<TextView>& keys, bool foldCase, unsigned threads,
+        std::vector<std::uint32_t>& out) {
+        const size_t n = keys.size();
+        out.resize(n);
+        if (n == 0) return;
+
+        std::unique_ptr<ThreadPool> pool;
+        if (n >= kParallelMin && threads != 1) {
+            pool.reset(new ThreadPool(threads));
+            if (pool->size() < 2) pool.reset();
+        }
+
+        std::vector<Item> items(n), tmp(n);
+        auto firstKeys = [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i)
+                items[i] = Item{ chunkKey(keys[i], 0, foldCase), static_cast<std::uint32_t>(i) };
+        };
+        if (pool) pool->parallelFor(n, (n + pool->size() - 1) / pool->size(), firstKeys);
+        else firstKeys(0, n);
+
+        sortRun(items.data(), tmp.data(), n, pool.get());
+
+        // Ties on the first 8 bytes: re-key each run on the next 8 and sort
+        // it again; once every string in a run has ended, shorter sorts first.
+        struct Run { size_t begin, end, depth; };
+        std::vector<Run> work;
+        work.push_back(Run{ 0, n, 0 });
+        while (!work.empty()) {
+            const Run r = work.back();
+            work.pop_back();
+            for (size_t b = r.begin; b < r.end;) {
+                size_t e = b + 1;
+                while (e < r.end && items[e].key == items[b].key) ++e;
+                if (e - b > 1) {
+                    const size_t next = (r.depth + 1) * 8;
+                    bool longer = false;
+                    for (size_t i = b; i < e && !longer; ++i) longer = keys[items[i].idx].size > next;
+                    if (longer) {
+                        for (size_t i = b; i < e; ++i) items[i].key = chunkKey(keys[items[i].idx], next, foldCase);
+                        sortRun(&items[b], &tmp[b], e - b, pool.get());
+                        work.push_back(Run{ b, e, r.depth + 1 });
+                    }
+                    else {
+                        std::stable_sort(items.begin() + b, items.begin() + e,
+                            [&](const Item& x, const Item& y) { return keys[x.idx].size < keys[y.idx].size; });
+                    }
+                }
+                b = e;
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i) out[i] = items[i].idx;
+    }
+
+} // namespace keysort
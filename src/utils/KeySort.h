@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "io/CsvScanner.h"
+
+// String sorting by precomputed collation keys.
+//
+// Each string is reduced to 8-byte big-endian chunks (ASCII-folded when
+// asked), so comparing two chunks as integers orders the strings. The
+// (chunk, index) pairs are radix sorted, the histogram/scatter passes split
+// over a thread pool for large inputs. Runs that still tie are re-keyed on
+// their next 8 bytes and sorted again, until the strings end. The result
+// is an index permutation: callers apply it to their own records, which
+// are never compared or moved during the sort.
+namespace keysort {
+
+    // Ascending, stable order of `keys`: out[i] is the index of the i-th
+    // smallest. Bytes compare as unsigned char, like std::string; with
+    // foldCase, A-Z compare as a-z. threads: 0 = hardware concurrency,
+    // 1 = no pool (small inputs never use one).
+    void order(const std::vector<TextView>& keys, bool foldCase, unsigned threads,
+        std::vector<std::uint32_t>& out);
+
+} // namespace keysort
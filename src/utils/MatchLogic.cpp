@@ -1,66 +1,35 @@
 #include "utils/MatchLogic.h"
+#include "io/CsvReader.h"
+#include "utils/ThreadPool.h"
+#include "utils/TopK.h"
+#include "utils/TokenDictionary.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 // ---- helpers ----
-static char toLowerChar(char c) {
-    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-}
-
-static std::string toLowerTrim(std::string s) {
-    // trim left
-    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.erase(s.begin());
-    // trim right
-    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.pop_back();
-    std::transform(s.begin(), s.end(), s.begin(), toLowerChar);
-    return s;
-}
-
-// split by multiple delimiters: | , ; /
-static std::vector<std::string> splitByAny(const std::string& s, const std::string& delims = "|,;/") {
-    std::vector<std::string> out;
-    std::string cur;
-    for (char c : s) {
-        if (delims.find(c) != std::string::npos) {
-            if (!cur.empty()) { out.push_back(cur); cur.clear(); }
-        }
-        else {
-            cur.push_back(c);
-        }
-    }
-    if (!cur.empty()) out.push_back(cur);
-    return out;
-}
-
-static std::unordered_set<std::string> toSet(const std::string& raw) {
-    std::unordered_set<std::string> s;
-    for (auto& part : splitByAny(raw)) {
-        auto t = toLowerTrim(part);
-        if (!t.empty()) s.insert(t);
-    }
-    return s;
-}
-
-static int overlapScore(const std::unordered_set<std::string>& a,
-    const std::unordered_set<std::string>& b) {
-    int score = 0;
-    for (const auto& k : a) if (b.count(k)) ++score;
-    return score;
+// Skill sets are interned, sorted id vectors built once at insert time,
+// so overlap is a linear integer merge.
+static int overlapScore(const TokenIds& a, const TokenIds& b) {
+    return static_cast<int>(tokens::intersectCount(a, b));
 }
 
 // ---- match logic ----
 void MatchLogic::matchLinkedLists(const ResumeLinkedList& resumes,
     const JobLinkedList& jobs)
 {
-    struct JobView { int id; std::string title; std::unordered_set<std::string> need; };
+    struct JobView { int id; std::string title; const TokenIds* need; };
     std::vector<JobView> jobVec;
     jobs.forEach([&](const JobLinkedList::Job& j) {
-        jobVec.push_back({ j.id, j.title, toSet(j.required) });
+        jobVec.push_back({ j.id, j.title, &j.skillIds });
         });
 
     if (jobVec.empty()) {
@@ -70,25 +39,377 @@ void MatchLogic::matchLinkedLists(const ResumeLinkedList& resumes,
 
     bool anyPrinted = false;
     resumes.forEach([&](const ResumeLinkedList::Resume& r) {
-        auto have = toSet(r.skills);
-        std::vector<std::pair<int, size_t>> scores; 
+        const TokenIds& have = r.skillIds;
+        TopK<int> best(3);
+        std::vector<TopK<int>::Entry> scores;
         for (size_t i = 0; i < jobVec.size(); ++i) {
-            int s = overlapScore(have, jobVec[i].need);
-            if (s > 0) scores.emplace_back(s, i);
+            int s = overlapScore(have, *jobVec[i].need);
+            if (s > 0) best.offer(s, i);
         }
+        best.take(scores);
         if (scores.empty()) {
             std::cout << "Candidate: " << r.name << "  no matches.\n";
             return;
         }
-        std::sort(scores.begin(), scores.end(), [](auto& a, auto& b) { return a.first > b.first; });
         std::cout << "Candidate: " << r.name << " matches:\n";
-        size_t topk = std::min<size_t>(3, scores.size());
-        for (size_t k = 0; k < topk; ++k) {
-            const auto& jv = jobVec[scores[k].second];
-            std::cout << "  - " << jv.title << "  (score: " << scores[k].first << ")\n";
+        for (const auto& e : scores) {
+            const auto& jv = jobVec[e.id];
+            std::cout << "  - " << jv.title << "  (score: " << e.score << ")\n";
         }
         anyPrinted = true;
         });
 
     if (!anyPrinted) std::cout << "[i] Matching finished. No overlapping skills found.\n";
 }
+
+
+// ---- parallel batch matching ----
+namespace {
+    struct JobView { const JobLinkedList::Job* job; const TokenIds* need; };
+}
+
+void MatchLogic::matchAllParallel(const ResumeLinkedList& resumes,
+    const JobLinkedList& jobs, size_t topK, unsigned threads,
+    std::vector<ResumeMatches>& out)
+{
+    out.clear();
+
+    std::vector<JobView> jobVec;
+    jobs.forEach([&](const JobLinkedList::Job& j) {
+        jobVec.push_back({ &j, &j.skillIds });
+        });
+
+    std::vector<const ResumeLinkedList::Resume*> rows;
+    rows.reserve(resumes.size());
+    resumes.forEach([&](const ResumeLinkedList::Resume& r) { rows.push_back(&r); });
+
+    out.resize(rows.size());
+    if (rows.empty()) return;
+
+    auto matchRange = [&](size_t begin, size_t end) {
+        // ids are job positions, so ties keep job order
+        TopK<int> best(topK);
+        std::vector<TopK<int>::Entry> kept;
+        for (size_t r = begin; r < end; ++r) {
+            const TokenIds& have = rows[r]->skillIds;
+            for (size_t i = 0; i < jobVec.size() && topK > 0; ++i) {
+                const int s = overlapScore(have, *jobVec[i].need);
+                if (s > 0) best.offer(s, i);
+            }
+            best.take(kept);
+
+            ResumeMatches& m = out[r];
+            m.resume = rows[r];
+            m.top.reserve(kept.size());
+            for (const auto& e : kept) m.top.push_back({ jobVec[e.id].job, e.score });
+        }
+    };
+
+    // one thread: run here rather than on a pool of one (the match server
+    // calls this from its own workers)
+    if (threads == 1) { matchRange(0, rows.size()); return; }
+
+    ThreadPool pool(threads);
+    // many small chunks so idle workers have something to steal
+    size_t grain = rows.size() / (static_cast<size_t>(pool.size()) * 16);
+    if (grain == 0) grain = 1;
+    pool.parallelFor(rows.size(), grain, matchRange);
+}
+
+void MatchLogic::topJobsForResume(const ResumeLinkedList::Resume& resume,
+    const JobLinkedList& jobs, size_t k, std::vector<ScoredJob>& out)
+{
+    out.clear();
+    const skills::SkillMatrix& matrix = jobs.skillMatrix();
+    const size_t n = matrix.size();
+
+    TopK<double, int> best(k);
+    const size_t kBlock = 256;
+    double block[kBlock];
+    for (size_t b = 0; b < n && k > 0; b += kBlock) {
+        const size_t e = std::min(n, b + kBlock);
+        skills::jaccardRange(resume.skillBits, matrix, b, e, block);
+        for (size_t row = b; row < e; ++row) {
+            const double s = block[row - b];
+            // only a tie with the weakest kept score needs the job id
+            if (best.full() && s < best.weakest().score) continue;
+            best.offer(s, jobs.jobAtRow(row).id);
+        }
+    }
+
+    std::vector<TopK<double, int>::Entry> kept;
+    best.take(kept);
+    out.reserve(kept.size());
+    for (const auto& e : kept) out.push_back({ jobs.searchById(e.id), e.score });
+}
+
+// one resume's block; false when it had no match
+static bool writeMatch(std::ostream& os, const MatchLogic::ResumeMatches& m)
+{
+    if (m.top.empty()) {
+        os << "Candidate: " << m.resume->name << "  no matches.\n";
+        return false;
+    }
+    os << "Candidate: " << m.resume->name << " matches:\n";
+    for (const auto& h : m.top)
+        os << "  - " << h.job->title << "  (score: " << h.score << ")\n";
+    return true;
+}
+
+static const char* const kNoMatches = "[i] Matching finished. No overlapping skills found.\n";
+
+void MatchLogic::writeMatches(std::ostream& os, const std::vector<ResumeMatches>& results)
+{
+    std::ostringstream buf;
+    bool anyPrinted = false;
+    for (const auto& m : results)
+        if (writeMatch(buf, m)) anyPrinted = true;
+    if (!anyPrinted) buf << kNoMatches;
+    os << buf.str();
+}
+
+
+// ---- streaming bulk match ----
+bool MatchLogic::streamMatch(const std::string& resumesCsv, const JobLinkedList& jobs,
+    size_t topK, unsigned threads, size_t windowBytes, std::ostream& os, StreamStats* stats)
+{
+    StreamStats local;
+    StreamStats& st = stats ? *stats : local;
+    st = StreamStats();
+
+    // skill phrase id -> rows of the jobs requiring it
+    const size_t jobCount = jobs.rowCount();
+    std::vector<std::vector<std::uint32_t>> postings;
+    for (size_t row = 0; row < jobCount; ++row) {
+        for (TokenId id : jobs.jobAtRow(row).skillIds) {
+            if (id >= postings.size()) postings.resize(id + 1);
+            postings[id].push_back(static_cast<std::uint32_t>(row));
+        }
+    }
+
+    ThreadPool pool(threads);
+    std::vector<ResumeMatches> results;
+    bool anyPrinted = false;
+
+    // overlap = shared phrase count, summed from the postings; only jobs
+    // sharing a phrase are touched (score 0 is never kept). The per-job
+    // counters outlive the batches: a chunk borrows a set, resets only the
+    // slots it touched and hands it back, so at most one set per worker is
+    // ever allocated and none is zero-filled again.
+    struct Scratch {
+        std::vector<int>           shared;
+        std::vector<std::uint32_t> touched;
+    };
+    std::mutex scratchMutex;
+    std::vector<std::unique_ptr<Scratch>> spare;
+
+    auto matchBatch = [&](std::vector<ResumeLinkedList::Resume>& batch) {
+        results.assign(batch.size(), ResumeMatches());
+        size_t grain = batch.size() / (static_cast<size_t>(pool.size()) * 4);
+        if (grain == 0) grain = 1;
+
+        pool.parallelFor(batch.size(), grain, [&](size_t begin, size_t end) {
+            std::unique_ptr<Scratch> scratch;
+            {
+                std::lock_guard<std::mutex> lock(scratchMutex);
+                if (!spare.empty()) { scratch = std::move(spare.back()); spare.pop_back(); }
+            }
+            if (!scratch) {
+                scratch.reset(new Scratch());
+                scratch->shared.assign(jobCount, 0);
+            }
+            std::vector<int>& shared = scratch->shared;
+            std::vector<std::uint32_t>& touched = scratch->touched;
+            TopK<int> best(topK);
+            std::vector<TopK<int>::Entry> kept;
+            for (size_t r = begin; r < end; ++r) {
+                touched.clear();
+                for (TokenId id : batch[r].skillIds) {
+                    if (id >= postings.size()) continue;
+                    for (std::uint32_t job : postings[id])
+                        if (shared[job]++ == 0) touched.push_back(job);
+                }
+                for (std::uint32_t job : touched) {
+                    best.offer(shared[job], job);
+                    shared[job] = 0;
+                }
+                best.take(kept);
+
+                ResumeMatches& m = results[r];
+                m.resume = &batch[r];
+                m.top.reserve(kept.size());
+                for (const auto& e : kept) m.top.push_back({ &jobs.jobAtRow(e.id), e.score });
+            }
+            std::lock_guard<std::mutex> lock(scratchMutex);
+            spare.push_back(std::move(scratch));
+            });
+
+        std::ostringstream buf;
+        for (const auto& m : results) {
+            if (writeMatch(buf, m)) { anyPrinted = true; ++st.matched; }
+        }
+        os << buf.str();
+
+        st.resumes += batch.size();
+        ++st.batches;
+        if (batch.size() > st.largestBatch) st.largestBatch = batch.size();
+    };
+
+    const bool ok = CsvReader::streamResumes(resumesCsv, pool, windowBytes, matchBatch);
+    if (!anyPrinted) os << kNoMatches;
+    return ok;
+}
+
+
+// ---- Jaccard matching, exact or LSH-filtered ----
+void MatchLogic::buildJobLsh(const JobLinkedList& jobs, MinHashLsh& lsh)
+{
+    lsh.clear();
+    for (size_t row = 0; row < jobs.rowCount(); ++row)
+        lsh.add(static_cast<MinHashLsh::Row>(row), jobs.jobAtRow(row).skillIds);
+}
+
+size_t MatchLogic::matchAllJaccard(const ResumeLinkedList& resumes,
+    const JobLinkedList& jobs, const MinHashLsh* lsh, size_t topK, unsigned threads,
+    std::vector<JaccardMatches>& out)
+{
+    out.clear();
+
+    std::vector<const ResumeLinkedList::Resume*> rows;
+    rows.reserve(resumes.size());
+    resumes.forEach([&](const ResumeLinkedList::Resume& r) { rows.push_back(&r); });
+
+    out.resize(rows.size());
+    if (rows.empty()) return 0;
+
+    const size_t jobCount = jobs.rowCount();
+    std::atomic<size_t> scored{ 0 };
+
+    ThreadPool pool(threads);
+    size_t grain = rows.size() / (static_cast<size_t>(pool.size()) * 16);
+    if (grain == 0) grain = 1;
+
+    pool.parallelFor(rows.size(), grain, [&](size_t begin, size_t end) {
+        TopK<double> best(topK);
+        std::vector<TopK<double>::Entry> kept;
+        std::vector<MinHashLsh::Row> cand;
+        std::vector<std::uint8_t> seen;
+        size_t local = 0;
+        for (size_t r = begin; r < end; ++r) {
+            const TokenIds& have = rows[r]->skillIds;
+            auto score = [&](size_t job) {
+                const double s = tokens::jaccard(have, jobs.jobAtRow(job).skillIds);
+                if (s > 0) best.offer(s, job);
+            };
+            if (lsh) {
+                lsh->candidates(have, cand, seen);
+                for (MinHashLsh::Row job : cand) score(job);
+                local += cand.size();
+            }
+            else {
+                for (size_t job = 0; job < jobCount; ++job) score(job);
+                local += jobCount;
+            }
+            best.take(kept);
+
+            JaccardMatches& m = out[r];
+            m.resume = rows[r];
+            m.top.reserve(kept.size());
+            for (const auto& e : kept) m.top.push_back({ &jobs.jobAtRow(e.id), e.score });
+        }
+        scored.fetch_add(local);
+        });
+    return scored.load();
+}
+
+double MatchLogic::recallAtK(const std::vector<JaccardMatches>& exact,
+    const std::vector<JaccardMatches>& approx, double tolerance)
+{
+    size_t wanted = 0, found = 0;
+    for (size_t r = 0; r < exact.size(); ++r) {
+        const auto& e = exact[r].top;
+        wanted += e.size();
+        if (r >= approx.size()) continue;
+        const auto& a = approx[r].top;
+        // both lists are best first: count the common scores
+        size_t i = 0, j = 0;
+        while (i < e.size() && j < a.size()) {
+            if (std::fabs(e[i].score - a[j].score) <= tolerance) { ++found; ++i; ++j; }
+            else if (e[i].score > a[j].score) ++i;
+            else ++j;
+        }
+    }
+    return wanted ? (double)found / (double)wanted : 1.0;
+}
+
+
+// ---- TF-IDF cosine ----
+void MatchLogic::topJobsWeighted(const ResumeLinkedList::Resume& resume,
+    const JobLinkedList& jobs, const WeightedIndex& index, size_t k, std::vector<ScoredJob>& out)
+{
+    out.clear();
+    std::vector<WeightedIndex::Term> terms;
+    std::vector<float> weights;
+    WeightedIndex::Accumulator acc;
+    std::vector<WeightedIndex::Hit> hits;
+    index.topJobs(index.vectorize(resume.skillIds, terms, weights), k, acc, hits);
+    out.reserve(hits.size());
+    for (const auto& h : hits) out.push_back({ &jobs.jobAtRow(h.id), h.score });
+}
+
+size_t MatchLogic::matchAllWeighted(const ResumeLinkedList& resumes,
+    const JobLinkedList& jobs, const WeightedIndex& index, size_t topK, unsigned threads,
+    std::vector<WeightedMatches>& out)
+{
+    out.clear();
+    const size_t n = std::min(resumes.rowCount(), index.resumeCount());
+    out.resize(n);
+    if (n == 0) return 0;
+
+    std::atomic<size_t> scored{ 0 };
+    ThreadPool pool(threads);
+    size_t grain = n / (static_cast<size_t>(pool.size()) * 16);
+    if (grain == 0) grain = 1;
+
+    pool.parallelFor(n, grain, [&](size_t begin, size_t end) {
+        WeightedIndex::Accumulator acc;
+        std::vector<WeightedIndex::Hit> hits;
+        size_t local = 0;
+        for (size_t r = begin; r < end; ++r) {
+            local += index.topJobs(index.resumeVector(r), topK, acc, hits);
+            WeightedMatches& m = out[r];
+            m.resume = &resumes.resumeAtRow(r);
+            m.top.reserve(hits.size());
+            for (const auto& h : hits) m.top.push_back({ &jobs.jobAtRow(h.id), h.score });
+        }
+        scored.fetch_add(local);
+        });
+    return scored.load();
+}
+
+// ---- dense all-pairs ----
+void MatchLogic::matchAllDense(const ResumeLinkedList& resumes, const JobLinkedList& jobs,
+    const DenseEmbedding& dense, size_t topK, unsigned threads,
+    std::vector<WeightedMatches>& out)
+{
+    out.clear();
+    const size_t n = std::min(resumes.rowCount(), dense.resumeCount());
+    out.resize(n);
+    if (n == 0) return;
+
+    ThreadPool pool(threads);
+    // a group of resumes shares each pass over a block of job panels
+    size_t grain = n / (static_cast<size_t>(pool.size()) * 16);
+    grain = std::max<size_t>(64, std::min<size_t>(grain, 256));
+
+    pool.parallelFor(n, grain, [&](size_t begin, size_t end) {
+        std::vector<std::vector<DenseEmbedding::Hit>> hits;
+        dense.topJobs(begin, end, topK, hits);
+        for (size_t r = begin; r < end; ++r) {
+            WeightedMatches& m = out[r];
+            m.resume = &resumes.resumeAtRow(r);
+            m.top.reserve(hits[r - begin].size());
+            for (const auto& h : hits[r - begin]) m.top.push_back({ &jobs.jobAtRow(h.id), h.score });
+        }
+        });
+}
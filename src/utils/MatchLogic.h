@@ -1,7 +1,106 @@
 #pragma once
+#include <cstddef>
+#include <ostream>
+#include <vector>
 #include "models/ResumeLinkedList.h"
 #include "models/JobLinkedList.h"
+#include "utils/DenseEmbedding.h"
+#include "utils/MinHashLsh.h"
+#include "utils/WeightedIndex.h"
 
 namespace MatchLogic {
     void matchLinkedLists(const ResumeLinkedList& resumes, const JobLinkedList& jobs);
+
+    struct JobHit {
+        const JobLinkedList::Job* job;
+        int score;
+    };
+
+    struct ResumeMatches {
+        const ResumeLinkedList::Resume* resume;
+        std::vector<JobHit> top;   // best first; ties keep job order
+    };
+
+    // All resumes x all jobs on a work-stealing pool (threads = 0 -> all cores,
+    // 1 -> on the calling thread, no pool).
+    // Each resume keeps a bounded top-K heap; out[i] is the i-th resume in list order.
+    void matchAllParallel(const ResumeLinkedList& resumes, const JobLinkedList& jobs,
+        size_t topK, unsigned threads, std::vector<ResumeMatches>& out);
+
+    struct ScoredJob {
+        const JobLinkedList::Job* job;
+        double score;
+    };
+
+    // Skill-bitset Jaccard of one resume against every job, keeping only the
+    // best k (ties -> smaller job id). Jobs are scored in small blocks fed to a
+    // bounded heap, so no per-job score array is kept. out is best first.
+    void topJobsForResume(const ResumeLinkedList::Resume& resume, const JobLinkedList& jobs,
+        size_t k, std::vector<ScoredJob>& out);
+
+    // Same layout matchLinkedLists prints, written in one go to `os`.
+    void writeMatches(std::ostream& os, const std::vector<ResumeMatches>& results);
+
+    struct StreamStats {
+        size_t resumes = 0;       // matched and written
+        size_t matched = 0;       // ... with at least one job
+        size_t batches = 0;
+        size_t largestBatch = 0;  // most resumes held at once
+    };
+
+    // Bulk match without loading the resumes. The jobs are indexed once
+    // (skill phrase id -> job rows); resumesCsv is then read through a
+    // `windowBytes` window (CsvReader::streamResumes), and each batch is
+    // matched on the pool and written to `os` before the next one is read.
+    // Memory is the job index plus one batch, whatever the file size. Scores,
+    // ties and output text are those of matchAllParallel + writeMatches.
+    bool streamMatch(const std::string& resumesCsv, const JobLinkedList& jobs, size_t topK,
+        unsigned threads, size_t windowBytes, std::ostream& os, StreamStats* stats = nullptr);
+
+    // ---- Jaccard over skill phrase ids: exact and MinHash/LSH ----
+    struct JaccardMatches {
+        const ResumeLinkedList::Resume* resume;
+        std::vector<ScoredJob> top;   // best first; ties keep job order
+    };
+
+    // Indexes every job's skill phrase ids under its row.
+    void buildJobLsh(const JobLinkedList& jobs, MinHashLsh& lsh);
+
+    // Top-K jobs per resume by phrase-id Jaccard, on the pool like
+    // matchAllParallel. With lsh == nullptr every job is scored (exact path);
+    // otherwise only the jobs sharing an LSH bucket with the resume are, and
+    // those are scored exactly. Returns the number of (resume, job) scorings.
+    size_t matchAllJaccard(const ResumeLinkedList& resumes, const JobLinkedList& jobs,
+        const MinHashLsh* lsh, size_t topK, unsigned threads,
+        std::vector<JaccardMatches>& out);
+
+    // Share of the exact top-K hits also found by the approximate run,
+    // compared by score so equally good tied jobs count (1 when exact is empty).
+    // Scores within `tolerance` are equal (runs computed in another order).
+    double recallAtK(const std::vector<JaccardMatches>& exact,
+        const std::vector<JaccardMatches>& approx, double tolerance = 0.0);
+
+    // ---- TF-IDF cosine over skill phrase ids (utils/WeightedIndex.h) ----
+    using WeightedMatches = JaccardMatches;   // score = cosine in [0, 1]
+
+    // Top-K jobs for one resume. Its vector is computed from its phrases,
+    // so it need not be one of the resumes `index` was built from.
+    void topJobsWeighted(const ResumeLinkedList::Resume& resume, const JobLinkedList& jobs,
+        const WeightedIndex& index, size_t k, std::vector<ScoredJob>& out);
+
+    // Top-K jobs for every resume from its precomputed vector, on the pool
+    // like matchAllParallel; out[i] is resume row i (insertion order). Only
+    // jobs sharing a phrase are scored; returns how many pairs that was.
+    size_t matchAllWeighted(const ResumeLinkedList& resumes, const JobLinkedList& jobs,
+        const WeightedIndex& index, size_t topK, unsigned threads,
+        std::vector<WeightedMatches>& out);
+
+    // ---- dense all-pairs (utils/DenseEmbedding.h) ----
+    // High-throughput variant of matchAllWeighted over hashed embeddings:
+    // every (resume, job) pair is scored by the blocked SIMD kernel, groups
+    // of resumes on the pool. out[i] is resume row i; scores estimate the
+    // TF-IDF cosine (exact when no phrases share a slot).
+    void matchAllDense(const ResumeLinkedList& resumes, const JobLinkedList& jobs,
+        const DenseEmbedding& dense, size_t topK, unsigned threads,
+        std::vector<WeightedMatches>& out);
 }
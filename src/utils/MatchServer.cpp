@@ -0,0 +1,332 @@
+#include "utils/MatchServer.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // How often the I/O thread looks at the stop flag.
+    const int kPollMs = 100;
+    // A client that stops reading its replies is dropped after this long,
+    // rather than holding a worker (and shutdown) for good.
+    const int kSendTimeoutMs = 5000;
+    // Longest command line; a client sending more without a '\n' is dropped
+    // instead of growing its receive buffer without bound.
+    const size_t kMaxLineBytes = 64 * 1024;
+
+    const char* const kServeUsage =
+        "usage: JobMatchingDSA --serve <unix:/path.sock|[host:]port> [--workers N] [--limit N]\n"
+        "                      [--threads N] [--resumes csv] [--jobs csv] [--snapshot file]\n";
+    const char* const kLoadUsage =
+        "usage: JobMatchingDSA --loadgen <unix:/path.sock|[host:]port> --commands file\n"
+        "                      [--connections C] [--requests N] [--shutdown]\n";
+
+    bool parseCount(const std::string& s, long& out) {
+        if (s.empty()) return false;
+        char* end = nullptr;
+        out = std::strtol(s.c_str(), &end, 10);
+        return *end == '\0' && out >= 0;
+    }
+
+    // One client. The I/O thread reads its lines into `queue`; a single pool
+    // task at a time drains it, so replies leave in request order.
+    struct Connection {
+        Socket                  sock;
+        std::mutex              m;
+        std::deque<std::string> queue;            // received, not yet answered
+        bool                    busy = false;     // a task is draining queue
+        bool                    dropped = false;  // a reply could not be sent
+        bool                    closed = false;   // peer hung up (I/O thread only)
+
+        explicit Connection(Socket s) : sock(std::move(s)) {}
+    };
+
+    struct Server {
+        BatchRunner::Options         run;     // opt.data, one thread per command
+        const BatchRunner::Dataset&  data;
+        std::atomic<bool>            stop{ false };
+        size_t                       connections = 0;
+        std::atomic<size_t>          requests{ 0 };
+        std::atomic<size_t>          failed{ 0 };
+
+        // A command spawning its own pool of all cores inside a worker
+        // would multiply the threads by the clients: the workers are the
+        // parallelism, so match-all and sort run on the calling worker.
+        Server(const MatchServer::Options& o, const BatchRunner::Dataset& d) : run(o.data), data(d) {
+            run.threads = 1;
+        }
+
+        // Pool task: answers the queued lines of `c` until none are left.
+        void drain(Connection& c) {
+            std::string line;
+            std::ostringstream reply;
+            for (;;) {
+                {
+                    std::lock_guard<std::mutex> lock(c.m);
+                    if (c.queue.empty()) { c.busy = false; return; }
+                    line = std::move(c.queue.front());
+                    c.queue.pop_front();
+                }
+                reply.str("");
+                reply << '{';
+                if (line == "shutdown") {
+                    reply << "\"cmd\":\"shutdown\",\"ok\":true";
+                    stop = true;
+                }
+                else {
+                    // nothing a client sends may take the server down: a
+                    // command that throws (out of memory, say) fails alone
+                    bool ok = false;
+                    try {
+                        ok = BatchRunner::execute(run, data, line, reply);
+                    }
+                    catch (const std::bad_alloc&) {
+                        reply.str("");
+                        reply << "{\"ok\":false,\"error\":\"out of memory\"";
+                    }
+                    catch (const std::exception&) {
+                        reply.str("");
+                        reply << "{\"ok\":false,\"error\":\"internal error\"";
+                    }
+                    if (!ok) ++failed;
+                }
+                reply << "}\n";
+                ++requests;
+                if (!c.sock.sendAll(reply.str())) {
+                    // the peer left or stopped reading: forget its queue and
+                    // wake the I/O thread, which removes the connection
+                    {
+                        std::lock_guard<std::mutex> lock(c.m);
+                        c.dropped = true;
+                        c.queue.clear();
+                        c.busy = false;
+                    }
+                    c.sock.shutdown();
+                    return;
+                }
+            }
+        }
+    };
+
+    struct Percentiles {
+        double p50 = 0, p99 = 0, max = 0;
+    };
+
+    // Nearest-rank percentiles of `ms` (sorted in place).
+    Percentiles percentiles(std::vector<double>& ms) {
+        Percentiles p;
+        if (ms.empty()) return p;
+        std::sort(ms.begin(), ms.end());
+        auto at = [&](double q) {
+            size_t rank = (size_t)(q * ms.size() + 0.999999);
+            if (rank == 0) rank = 1;
+            return ms[std::min(rank, ms.size()) - 1];
+        };
+        p.p50 = at(0.50);
+        p.p99 = at(0.99);
+        p.max = ms.back();
+        return p;
+    }
+
+    std::string ms3(double ms) {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.3f", ms);
+        return buf;
+    }
+
+} // namespace
+
+bool MatchServer::parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n" << kServeUsage; return false; }
+        const std::string v = argv[++i];
+        long n = 0;
+        if (a == "--serve") {
+            if (!Endpoint::parse(v, opt.at)) { std::cerr << "bad endpoint " << v << "\n" << kServeUsage; return false; }
+        }
+        else if (a == "--workers" && parseCount(v, n)) opt.workers = (unsigned)n;
+        else if (!BatchRunner::parseDataOption(a, v, opt.data)) {
+            std::cerr << "bad option " << a << " " << v << "\n" << kServeUsage;
+            return false;
+        }
+    }
+    if (opt.at.unixPath.empty() && opt.at.port == 0) { std::cerr << kServeUsage; return false; }
+    return true;
+}
+
+bool MatchServer::parseLoadArgs(int argc, char** argv, LoadOptions& opt) {
+    bool haveEndpoint = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--shutdown") { opt.shutdown = true; continue; }
+        if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n" << kLoadUsage; return false; }
+        const std::string v = argv[++i];
+        long n = 0;
+        if (a == "--loadgen") {
+            haveEndpoint = Endpoint::parse(v, opt.at);
+            if (!haveEndpoint) { std::cerr << "bad endpoint " << v << "\n" << kLoadUsage; return false; }
+        }
+        else if (a == "--commands") opt.commands = v;
+        else if (a == "--connections" && parseCount(v, n) && n > 0) opt.connections = (unsigned)n;
+        else if (a == "--requests" && parseCount(v, n)) opt.requests = (size_t)n;
+        else { std::cerr << "bad option " << a << " " << v << "\n" << kLoadUsage; return false; }
+    }
+    if (!haveEndpoint || opt.commands.empty()) { std::cerr << kLoadUsage; return false; }
+    return true;
+}
+
+int MatchServer::serve(const Options& opt) {
+    BatchRunner::Dataset data;
+    const auto t0 = Clock::now();
+    if (!BatchRunner::load(opt.data, data).ok) {
+        std::cerr << "[serve] cannot load the dataset\n";
+        return 1;
+    }
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    std::string error;
+    Socket listener = Socket::listen(opt.at, error);
+    if (!listener.valid()) {
+        std::cerr << "[serve] cannot listen on " << opt.at.str() << ": " << error << "\n";
+        return 1;
+    }
+
+    Server server(opt, data);
+    {
+        ThreadPool pool(opt.workers);
+        std::cerr << "[serve] " << data.resumes.size() << " resumes, " << data.jobs.rowCount()
+            << " jobs loaded in " << ms3(loadMs) << " ms; listening on " << opt.at.str()
+            << " with " << pool.size() << " workers\n";
+
+        // shared with the tasks, which may outlive a hang-up
+        std::vector<std::shared_ptr<Connection>> conns;
+        std::vector<const Socket*> watch;
+        std::vector<char> ready;
+        std::string line;
+        while (!server.stop) {
+            watch.assign(1, &listener);
+            for (const auto& c : conns) watch.push_back(&c->sock);
+            if (Socket::waitAny(watch, kPollMs, ready) <= 0) continue;
+
+            for (size_t i = 0; i < conns.size(); ++i) {
+                if (!ready[i + 1]) continue;
+                Connection& c = *conns[i];
+                if (c.sock.receive() < 0) { c.closed = true; continue; }
+
+                bool start = false;
+                {
+                    std::lock_guard<std::mutex> lock(c.m);
+                    if (c.dropped) { c.closed = true; continue; }
+                    while (c.sock.takeLine(line))
+                        if (!line.empty() && line[0] != '#') c.queue.push_back(line);
+                    if (c.sock.buffered() > kMaxLineBytes) {
+                        c.closed = true;
+                        c.queue.clear();
+                        continue;
+                    }
+                    start = !c.busy && !c.queue.empty();
+                    if (start) c.busy = true;
+                }
+                if (start) {
+                    std::shared_ptr<Connection> keep = conns[i];
+                    pool.submit([&server, keep]() { server.drain(*keep); });
+                }
+            }
+            conns.erase(std::remove_if(conns.begin(), conns.end(),
+                [](const std::shared_ptr<Connection>& c) { return c->closed; }), conns.end());
+
+            if (ready[0]) {
+                Socket client = listener.accept();
+                if (client.valid()) {
+                    client.setSendTimeout(kSendTimeoutMs);
+                    conns.push_back(std::make_shared<Connection>(std::move(client)));
+                    ++server.connections;
+                }
+            }
+        }
+        pool.wait();
+    }
+    listener.close();
+
+    std::cerr << "[serve] stopped after " << server.requests << " requests ("
+        << server.failed << " failed) on " << server.connections << " connections\n";
+    return 0;
+}
+
+int MatchServer::loadgen(const LoadOptions& opt) {
+    std::ifstream in(opt.commands);
+    if (!in.is_open()) { std::cerr << "[loadgen] cannot open " << opt.commands << "\n"; return 1; }
+    std::vector<std::string> commands;
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (!line.empty() && line[0] != '#' && line != "shutdown") commands.push_back(line + "\n");
+    }
+    if (commands.empty()) { std::cerr << "[loadgen] no commands in " << opt.commands << "\n"; return 1; }
+
+    // every connection first, so none of the timing includes a connect
+    std::vector<Socket> conns;
+    for (unsigned c = 0; c < opt.connections; ++c) {
+        std::string error;
+        conns.push_back(Socket::connect(opt.at, error));
+        if (!conns.back().valid()) { std::cerr << "[loadgen] " << error << "\n"; return 1; }
+    }
+
+    // request i sends commands[i % size]; connections take the next i
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> errors{ 0 };
+    std::vector<std::vector<double>> latencies(conns.size());
+    std::vector<std::thread> threads;
+    const auto start = Clock::now();
+    for (size_t c = 0; c < conns.size(); ++c) {
+        threads.emplace_back([&, c]() {
+            Socket& s = conns[c];
+            std::string reply;
+            for (size_t i = next++; i < opt.requests; i = next++) {
+                const auto t0 = Clock::now();
+                if (!s.sendAll(commands[i % commands.size()]) || s.readLine(reply, -1) != 1) {
+                    ++errors;
+                    break;
+                }
+                latencies[c].push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+                if (reply.find("\"ok\":true") == std::string::npos) ++errors;
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    const size_t answered = all.size();
+    const Percentiles p = percentiles(all);
+
+    std::cout << "{\"endpoint\":\"" << opt.at.str() << "\",\"connections\":" << conns.size()
+        << ",\"requests\":" << answered << ",\"errors\":" << errors
+        << ",\"seconds\":" << ms3(seconds)
+        << ",\"qps\":" << ms3(seconds > 0 ? answered / seconds : 0.0)
+        << ",\"p50_ms\":" << ms3(p.p50) << ",\"p99_ms\":" << ms3(p.p99)
+        << ",\"max_ms\":" << ms3(p.max) << "}\n";
+
+    if (opt.shutdown) {
+        conns.front().sendAll("shutdown\n");
+        conns.front().readLine(line, 5000);
+    }
+    return errors ? 2 : 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "io/Socket.h"
+#include "utils/BatchRunner.h"
+
+// Server mode: loads the dataset once and answers batch-mode commands
+// (utils/BatchRunner.h) over a Unix domain socket or a loopback TCP port.
+// One command per line in, one JSON line out, in order, per connection:
+//
+//     JobMatchingDSA --serve <unix:/path.sock|port> [--workers N] [--limit N] [--threads N]
+//
+// One I/O thread polls the listener and every client; received commands
+// run on a fixed pool of N workers that only read the shared lists, each
+// command on the one worker that took it (--threads only sets how many
+// threads load the data, so match-all never starts a pool of its own). Each
+// connection has at most one command in flight, so its replies keep request
+// order while different clients are answered concurrently. "shutdown"
+// stops the server after the commands already received.
+//
+// The load generator replays a command file over C connections (each
+// sends a command and waits for its reply) and prints one JSON line with
+// QPS and p50 / p99 latency:
+//
+//     JobMatchingDSA --loadgen <endpoint> --commands file [--connections C]
+//                    [--requests N] [--shutdown]
+namespace MatchServer {
+
+    struct Options {
+        Endpoint             at;
+        unsigned             workers = 0;   // 0 = all cores
+        BatchRunner::Options data;
+    };
+
+    struct LoadOptions {
+        Endpoint    at;
+        std::string commands;
+        unsigned    connections = 4;
+        size_t      requests = 1000;
+        bool        shutdown = false;   // send "shutdown" when done
+    };
+
+    // Arguments after the program name, starting with --serve / --loadgen.
+    bool parseArgs(int argc, char** argv, Options& opt);
+    bool parseLoadArgs(int argc, char** argv, LoadOptions& opt);
+
+    // Exit code 0 after a clean shutdown, 1 when the data or socket failed.
+    int serve(const Options& opt);
+    // Exit code 0 when every request was answered with "ok", 1 when the
+    // server could not be reached, 2 when some request failed.
+    int loadgen(const LoadOptions& opt);
+
+} // namespace MatchServer
@@ -0,0 +1,108 @@
+#include "utils/MinHashLsh.h"
+#include <cmath>
+#include <limits>
+
+// ---- hashing ----
+static inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+MinHashLsh::MinHashLsh() : MinHashLsh(Params()) {}
+
+MinHashLsh::MinHashLsh(const Params& params) : p(params) {
+    if (p.bands == 0) p.bands = 1;
+    if (p.rows == 0) p.rows = 1;
+    const size_t n = signatureSize();
+    hashMul.resize(n);
+    hashAdd.resize(n);
+    std::uint64_t state = p.seed;
+    for (size_t i = 0; i < n; ++i) {
+        hashMul[i] = splitmix64(state++) | 1;   // odd multiplier
+        hashAdd[i] = splitmix64(state++);
+    }
+    tables.resize(p.bands);
+}
+
+void MinHashLsh::signature(const TokenIds& set, std::vector<std::uint32_t>& sig) const {
+    const size_t n = signatureSize();
+    sig.assign(n, std::numeric_limits<std::uint32_t>::max());
+    for (TokenId id : set) {
+        const std::uint64_t x = splitmix64(id);
+        for (size_t i = 0; i < n; ++i) {
+            const std::uint32_t h = (std::uint32_t)((hashMul[i] * x + hashAdd[i]) >> 32);
+            if (h < sig[i]) sig[i] = h;
+        }
+    }
+}
+
+std::uint64_t MinHashLsh::bandKey(const std::uint32_t* values) const {
+    std::uint64_t k = 0;
+    for (unsigned r = 0; r < p.rows; ++r) k = splitmix64(k ^ values[r]);
+    return k;
+}
+
+// ---- index ----
+void MinHashLsh::add(Row row, const TokenIds& set) {
+    if (set.empty()) return;
+    std::vector<std::uint32_t> sig;
+    signature(set, sig);
+    for (unsigned b = 0; b < p.bands; ++b)
+        tables[b][bandKey(&sig[(size_t)b * p.rows])].push_back(row);
+    if (row > maxRow) maxRow = row;
+    ++indexed;
+}
+
+void MinHashLsh::clear() {
+    for (auto& t : tables) t.clear();
+    indexed = 0;
+    maxRow = 0;
+}
+
+void MinHashLsh::candidates(const TokenIds& set, std::vector<Row>& out,
+    std::vector<std::uint8_t>& seen) const {
+    out.clear();
+    if (set.empty() || indexed == 0) return;
+    if (seen.size() <= maxRow) seen.resize((size_t)maxRow + 1, 0);
+    std::vector<std::uint32_t> sig;
+    signature(set, sig);
+    for (unsigned b = 0; b < p.bands; ++b) {
+        auto it = tables[b].find(bandKey(&sig[(size_t)b * p.rows]));
+        if (it == tables[b].end()) continue;
+        for (Row r : it->second) {
+            if (seen[r]) continue;
+            seen[r] = 1;
+            out.push_back(r);
+        }
+    }
+    for (Row r : out) seen[r] = 0;
+}
+
+// ---- tuning ----
+double MinHashLsh::collisionProbability(double s, unsigned bands, unsigned rows) {
+    return 1.0 - std::pow(1.0 - std::pow(s, (double)rows), (double)bands);
+}
+
+MinHashLsh::Params MinHashLsh::tune(double threshold, double recall, unsigned maxHashes) {
+    Params best;
+    best.bands = maxHashes ? maxHashes : 1;
+    best.rows = 1;
+    double bestLeak = 2.0;
+    for (unsigned r = 1; maxHashes && r <= maxHashes; ++r) {
+        // fewest bands that reach the recall target with r rows each
+        for (unsigned b = 1; b * r <= maxHashes; ++b) {
+            if (collisionProbability(threshold, b, r) < recall) continue;
+            const double leak = collisionProbability(threshold / 2, b, r);
+            if (leak < bestLeak - 1e-9 ||
+                (leak < bestLeak + 1e-9 && b * r < best.bands * best.rows)) {
+                bestLeak = leak;
+                best.bands = b;
+                best.rows = r;
+            }
+            break;
+        }
+    }
+    return best;
+}
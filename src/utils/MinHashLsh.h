@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "utils/TokenDictionary.h"
+
+// MinHash signatures of token-id sets, bucketed by banded LSH.
+//
+// A signature has bands * rows min-hash values. Each band of `rows` values is
+// hashed into its own table, so two sets with Jaccard similarity s share at
+// least one bucket with probability 1 - (1 - s^rows)^bands. More rows make
+// the tables more selective; more bands raise recall.
+class MinHashLsh {
+public:
+    using Row = std::uint32_t;
+
+    struct Params {
+        unsigned bands = 16;
+        unsigned rows = 2;
+        std::uint64_t seed = 0x5DEECE66DULL;
+    };
+
+    MinHashLsh();
+    explicit MinHashLsh(const Params& p);
+
+    const Params& params() const { return p; }
+    size_t signatureSize() const { return (size_t)p.bands * p.rows; }
+
+    void signature(const TokenIds& set, std::vector<std::uint32_t>& sig) const;
+
+    // Indexes `set` under `row`. Empty sets are skipped (they never match).
+    void add(Row row, const TokenIds& set);
+    void clear();
+    size_t size() const { return indexed; }
+
+    // Rows sharing at least one band bucket with `set`, no repeats, in bucket
+    // order (not sorted). `seen` is per-caller scratch that replaces a sort:
+    // it grows to the largest row and is left all zero.
+    void candidates(const TokenIds& set, std::vector<Row>& out,
+        std::vector<std::uint8_t>& seen) const;
+
+    // Probability that two sets with Jaccard `s` become candidates.
+    static double collisionProbability(double s, unsigned bands, unsigned rows);
+
+    // (bands, rows) within maxHashes that reaches `recall` for pairs at
+    // Jaccard >= threshold while letting the fewest pairs at threshold / 2
+    // through (fewer hashes on a tie). Falls back to maxHashes 1-row bands.
+    static Params tune(double threshold, double recall, unsigned maxHashes = 128);
+
+private:
+    std::uint64_t bandKey(const std::uint32_t* values) const;
+
+    Params p;
+    std::vector<std::uint64_t> hashMul;   // one multiply-add hash per signature slot
+    std::vector<std::uint64_t> hashAdd;
+    std::vector<std::unordered_map<std::uint64_t, std::vector<Row>>> tables;   // per band
+    size_t indexed = 0;
+    Row maxRow = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Growable result buffer read back a page at a time. Searches append hits
+// as they find them (no count pass, no fixed-size array); the menu then
+// walks pages of `pageSize()` items.
+template<typename T>
+class PagedResults {
+public:
+    explicit PagedResults(std::size_t pageSize = 3) : perPage(pageSize ? pageSize : 1) {}
+
+    void clear() { items_.clear(); }
+    void push_back(const T& v) { items_.push_back(v); }
+
+    std::size_t size() const { return items_.size(); }
+    bool        empty() const { return items_.empty(); }
+    const T&    operator[](std::size_t i) const { return items_[i]; }
+
+    // Whole buffer, e.g. to sort it before paging.
+    std::vector<T>&       items() { return items_; }
+    const std::vector<T>& items() const { return items_; }
+
+    std::size_t pageSize() const { return perPage; }
+    std::size_t pageCount() const { return (items_.size() + perPage - 1) / perPage; }
+
+    // Item range [pageBegin(p), pageEnd(p)) of page p (0-based).
+    std::size_t pageBegin(std::size_t p) const {
+        const std::size_t b = p * perPage;
+        return b < items_.size() ? b : items_.size();
+    }
+    std::size_t pageEnd(std::size_t p) const {
+        const std::size_t e = pageBegin(p) + perPage;
+        return e < items_.size() ? e : items_.size();
+    }
+
+private:
+    std::vector<T> items_;
+    std::size_t    perPage;
+};
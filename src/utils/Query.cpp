@@ -0,0 +1,328 @@
+#include "utils/Query.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+// ---- lexer ----
+namespace {
+
+    struct Token {
+        enum Kind { Word, LParen, RParen, And, Or, Not, End } kind;
+        std::string field;   // Word: "" when unprefixed
+        std::string text;
+    };
+
+    // Reads a "quoted" run starting at s[i] == '"'; leaves i past the close.
+    bool readQuoted(const std::string& s, size_t& i, std::string& out, std::string& error) {
+        const size_t close = s.find('"', i + 1);
+        if (close == std::string::npos) { error = "missing closing quote"; return false; }
+        out.assign(s, i + 1, close - i - 1);
+        i = close + 1;
+        return true;
+    }
+
+    // `plain` stays true while nothing but bare words is seen.
+    bool lex(const std::string& s, std::vector<Token>& out, bool& plain, std::string& error) {
+        out.clear();
+        plain = true;
+        size_t i = 0;
+        while (i < s.size()) {
+            const char c = s[i];
+            if (std::isspace(static_cast<unsigned char>(c))) { ++i; continue; }
+            if (c == '(' || c == ')') {
+                out.push_back(Token{ c == '(' ? Token::LParen : Token::RParen, "", "" });
+                plain = false;
+                ++i;
+                continue;
+            }
+
+            Token t{ Token::Word, "", "" };
+            if (c == '"') {
+                if (!readQuoted(s, i, t.text, error)) return false;
+                plain = false;
+                out.push_back(t);
+                continue;
+            }
+
+            const size_t start = i;
+            while (i < s.size() && !std::isspace(static_cast<unsigned char>(s[i])) &&
+                s[i] != '(' && s[i] != ')' && s[i] != ':')
+                ++i;
+            t.text.assign(s, start, i - start);
+
+            if (i < s.size() && s[i] == ':' && !t.text.empty()) {
+                // field:value or field:"quoted value"
+                t.field.swap(t.text);
+                ++i;
+                if (i < s.size() && s[i] == '"') {
+                    if (!readQuoted(s, i, t.text, error)) return false;
+                }
+                else {
+                    const size_t v = i;
+                    while (i < s.size() && !std::isspace(static_cast<unsigned char>(s[i])) &&
+                        s[i] != '(' && s[i] != ')')
+                        ++i;
+                    t.text.assign(s, v, i - v);
+                }
+                if (t.text.empty()) { error = "no value after \"" + t.field + ":\""; return false; }
+                plain = false;
+            }
+            else if (i < s.size() && s[i] == ':') {
+                // a lone ':' is part of the word
+                ++i;
+                while (i < s.size() && !std::isspace(static_cast<unsigned char>(s[i])) &&
+                    s[i] != '(' && s[i] != ')')
+                    ++i;
+                t.text.assign(s, start, i - start);
+            }
+            // operators are upper case only: "and" / "or" / "not" stay
+            // plain words, as they always searched
+            else if (t.text == "AND") { t.kind = Token::And; plain = false; }
+            else if (t.text == "OR") { t.kind = Token::Or; plain = false; }
+            else if (t.text == "NOT") { t.kind = Token::Not; plain = false; }
+            out.push_back(t);
+        }
+        out.push_back(Token{ Token::End, "", "" });
+        return true;
+    }
+
+    // Field prefix -> Query::Field bits for the target; 0 if it has no such field.
+    unsigned fieldBits(const std::string& name, Query::Target target) {
+        std::string f = name;
+        for (char& c : f) c = CiPattern::fold(c);
+        const bool jobs = target == Query::Target::Jobs;
+        if (f == "skill" || f == "skills") return jobs ? Query::Required : Query::Skills;
+        if (f == "name") return jobs ? 0u : (unsigned)Query::Name;
+        if (f == "title") return jobs ? (unsigned)Query::Title : 0u;
+        if (f == "required" || f == "req") return jobs ? (unsigned)Query::Required : 0u;
+        return 0;
+    }
+
+} // namespace
+
+// ---- parser ----
+class QueryParser {
+public:
+    QueryParser(Query& q, const std::vector<Token>& toks, unsigned defaults, std::string& err)
+        : q(q), toks(toks), defaults(defaults), error(err) {}
+
+    int parse() {
+        const int n = parseOr();
+        if (n >= 0 && toks[pos].kind != Token::End) return fail("unexpected \"" + describe(toks[pos]) + "\"");
+        return n;
+    }
+
+    int term(unsigned fields, const std::string& text) {
+        Query::Node node{ Query::Kind::Term, fields, CiPattern(text), -1, -1 };
+        q.nodes.push_back(std::move(node));
+        return (int)q.nodes.size() - 1;
+    }
+
+private:
+    int add(Query::Kind kind, int left, int right) {
+        q.nodes.push_back(Query::Node{ kind, 0, CiPattern(), left, right });
+        return (int)q.nodes.size() - 1;
+    }
+
+    int fail(const std::string& msg) {
+        if (error.empty()) error = msg;
+        return -1;
+    }
+
+    static std::string describe(const Token& t) {
+        switch (t.kind) {
+        case Token::LParen: return "(";
+        case Token::RParen: return ")";
+        case Token::And: return "AND";
+        case Token::Or: return "OR";
+        case Token::Not: return "NOT";
+        case Token::End: return "end of query";
+        default: return t.field.empty() ? t.text : t.field + ":" + t.text;
+        }
+    }
+
+    int parseOr() {
+        int left = parseAnd();
+        while (left >= 0 && toks[pos].kind == Token::Or) {
+            ++pos;
+            const int right = parseAnd();
+            if (right < 0) return -1;
+            left = add(Query::Kind::Or, left, right);
+        }
+        return left;
+    }
+
+    int parseAnd() {
+        int left = parseUnary();
+        while (left >= 0) {
+            const Token::Kind k = toks[pos].kind;
+            if (k == Token::And) ++pos;
+            else if (k != Token::Word && k != Token::LParen && k != Token::Not) break;
+            const int right = parseUnary();
+            if (right < 0) return -1;
+            left = add(Query::Kind::And, left, right);
+        }
+        return left;
+    }
+
+    int parseUnary() {
+        const Token& t = toks[pos];
+        switch (t.kind) {
+        case Token::Not: {
+            ++pos;
+            const int operand = parseUnary();
+            return operand < 0 ? -1 : add(Query::Kind::Not, operand, -1);
+        }
+        case Token::LParen: {
+            ++pos;
+            const int inner = parseOr();
+            if (inner < 0) return -1;
+            if (toks[pos].kind != Token::RParen) return fail("missing \")\"");
+            ++pos;
+            return inner;
+        }
+        case Token::Word: {
+            ++pos;
+            unsigned fields = defaults;
+            if (!t.field.empty()) {
+                fields = fieldBits(t.field, q.on);
+                if (!fields)
+                    return fail(std::string(q.on == Query::Target::Jobs ? "jobs" : "resumes")
+                        + " have no \"" + t.field + "\" field");
+            }
+            return term(fields, t.text);
+        }
+        default:
+            return fail("expected a term before \"" + describe(t) + "\"");
+        }
+    }
+
+    Query& q;
+    const std::vector<Token>& toks;
+    size_t pos = 0;
+    unsigned defaults;
+    std::string& error;
+};
+
+bool Query::compile(const std::string& text, Target target, unsigned defaultFields,
+    std::string& error) {
+    nodes.clear();
+    root = -1;
+    on = target;
+    error.clear();
+
+    std::vector<Token> toks;
+    bool plain = true;
+    if (!lex(text, toks, plain, error)) return false;
+
+    QueryParser parser(*this, toks, defaultFields, error);
+    // plain keyword: the whole text, spaces included (empty matches all)
+    root = plain ? parser.term(defaultFields, text) : parser.parse();
+    if (root < 0) { nodes.clear(); return false; }
+    return true;
+}
+
+// ---- evaluation ----
+static const std::string& fieldText(const ResumeLinkedList::Resume& r, unsigned f) {
+    return f == Query::Name ? r.name : r.skills;
+}
+
+static const std::string& fieldText(const JobLinkedList::Job& j, unsigned f) {
+    return f == Query::Title ? j.title : j.required;
+}
+
+template<typename Rec>
+bool Query::matches(int node, const Rec& rec) const {
+    const Node& n = nodes[node];
+    switch (n.kind) {
+    case Kind::And: return matches(n.left, rec) && matches(n.right, rec);
+    case Kind::Or: return matches(n.left, rec) || matches(n.right, rec);
+    case Kind::Not: return !matches(n.left, rec);
+    default:
+        for (unsigned f = 1; f <= n.fields; f <<= 1)
+            if ((n.fields & f) && n.pattern.foundIn(fieldText(rec, f))) return true;
+        return false;
+    }
+}
+
+// Rows that can possibly match `node`, ascending; false when the indexes
+// cannot bound it (NOT, unindexed fields), i.e. every row must be checked.
+template<typename Lookup>
+bool Query::candidates(int node, Lookup lookup, InvertedIndex::Postings& out) const {
+    const Node& n = nodes[node];
+    InvertedIndex::Postings a, b;
+    out.clear();
+    switch (n.kind) {
+    case Kind::Not:
+        return false;
+    case Kind::And: {
+        const bool ka = candidates(n.left, lookup, a);
+        const bool kb = candidates(n.right, lookup, b);
+        if (ka && kb)
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+        else if (ka) out.swap(a);
+        else if (kb) out.swap(b);
+        return ka || kb;
+    }
+    case Kind::Or:
+        if (!candidates(n.left, lookup, a) || !candidates(n.right, lookup, b)) return false;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+        return true;
+    default:
+        for (unsigned f = 1; f <= n.fields; f <<= 1) {
+            if (!(n.fields & f)) continue;
+            if (!lookup(f, n.pattern.folded(), b)) return false;
+            a.clear();
+            std::set_union(out.begin(), out.end(), b.begin(), b.end(), std::back_inserter(a));
+            out.swap(a);
+        }
+        return true;
+    }
+}
+
+template<typename Rec, typename RowAt, typename Lookup>
+size_t Query::scan(size_t rows, RowAt rowAt, Lookup lookup, const SortedIndex* order,
+    PagedResults<const Rec*>& out) const {
+    out.clear();
+    if (root < 0) return 0;
+
+    std::vector<SortedIndex::Row> hits;
+    InvertedIndex::Postings cand;
+    if (candidates(root, lookup, cand)) {
+        for (InvertedIndex::Row r : cand)
+            if (matches(root, rowAt(r))) hits.push_back(r);
+    }
+    else {
+        for (size_t r = 0; r < rows; ++r)
+            if (matches(root, rowAt(r))) hits.push_back(static_cast<SortedIndex::Row>(r));
+    }
+
+    if (order) order->order(hits);
+    for (SortedIndex::Row r : hits) out.push_back(&rowAt(r));
+    return out.size();
+}
+
+size_t Query::run(const ResumeLinkedList& list,
+    PagedResults<const ResumeLinkedList::Resume*>& out, Order order) const {
+    if (on != Target::Resumes) { out.clear(); return 0; }
+    return scan<ResumeLinkedList::Resume>(list.rowCount(),
+        [&](size_t r) -> const ResumeLinkedList::Resume& { return list.resumeAtRow(r); },
+        [&](unsigned f, const std::string& k, InvertedIndex::Postings& rows) {
+            if (f != Skills) return false;
+            list.skillsKeywords().candidates(k, rows);
+            return true;
+        },
+        order == Order::Key ? &list.byName() : nullptr, out);
+}
+
+size_t Query::run(const JobLinkedList& list,
+    PagedResults<const JobLinkedList::Job*>& out, Order order) const {
+    if (on != Target::Jobs) { out.clear(); return 0; }
+    return scan<JobLinkedList::Job>(list.rowCount(),
+        [&](size_t r) -> const JobLinkedList::Job& { return list.jobAtRow(r); },
+        [&](unsigned f, const std::string& k, InvertedIndex::Postings& rows) {
+            (f == Title ? list.titleKeywords() : list.requiredKeywords()).candidates(k, rows);
+            return true;
+        },
+        order == Order::Key ? &list.byTitle() : nullptr, out);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "models/JobLinkedList.h"
+#include "models/ResumeLinkedList.h"
+#include "utils/CiPattern.h"
+#include "utils/PagedResults.h"
+
+// Small boolean query language over resume and job fields, e.g.
+//
+//     skill:sql AND title:engineer NOT skill:excel
+//     (python OR "machine learning") AND NOT name:intern
+//
+// Terms are case-insensitive substrings, optionally prefixed by a field
+// (name, skill/skills, title, required/req) and quoted when they contain
+// spaces. Adjacent terms are ANDed; AND, OR, NOT and parentheses work as
+// usual (NOT binds tightest, then AND, then OR). Operators are upper case
+// only, so "and" / "or" / "not" stay words. Text with no operator, field,
+// quote or parenthesis is one plain keyword, as the menu always took.
+//
+// compile() builds a predicate tree with every term folded once. run() asks
+// the keyword indexes for candidate rows where the tree allows it, then
+// evaluates the tree in a single pass over those rows. Matches come out in
+// insertion order, or in key order (resume name / job title) read from the
+// list's sorted index instead of sorting the results.
+class Query {
+public:
+    enum class Target { Resumes, Jobs };
+    enum Field : unsigned { Name = 1, Skills = 2, Title = 4, Required = 8 };
+    enum class Order { Rows, Key };
+
+    // `defaultFields` is what a term without a field prefix searches. On a
+    // jobs query "skill:" means the required column. Returns false with a
+    // message on a syntax error or a field the target does not have.
+    bool compile(const std::string& text, Target target, unsigned defaultFields,
+        std::string& error);
+
+    Target target() const { return on; }
+
+    // Appends every match; returns the hit count. The query must target the
+    // list's record type.
+    size_t run(const ResumeLinkedList& list,
+        PagedResults<const ResumeLinkedList::Resume*>& out, Order order = Order::Rows) const;
+    size_t run(const JobLinkedList& list,
+        PagedResults<const JobLinkedList::Job*>& out, Order order = Order::Rows) const;
+
+private:
+    enum class Kind { Term, And, Or, Not };
+    struct Node {
+        Kind      kind;
+        unsigned  fields;    // Term: fields to search
+        CiPattern pattern;   // Term: folded text
+        int       left;      // And/Or/Not operand
+        int       right;     // And/Or second operand
+    };
+
+    template<typename Rec>
+    bool matches(int node, const Rec& rec) const;
+    template<typename Lookup>
+    bool candidates(int node, Lookup lookup, InvertedIndex::Postings& out) const;
+    template<typename Rec, typename RowAt, typename Lookup>
+    size_t scan(size_t rows, RowAt rowAt, Lookup lookup, const SortedIndex* order,
+        PagedResults<const Rec*>& out) const;
+
+    friend class QueryParser;
+
+    std::vector<Node> nodes;
+    int    root = -1;
+    Target on = Target::Resumes;
+};
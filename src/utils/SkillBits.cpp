@@ -0,0 +1,159 @@
+#include "utils/SkillBits.h"
+#include "utils/AhoCorasick.h"
+#include <unordered_map>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace skills {
+
+    static const char* const kKeys[] = {
+        "python","java","sql","excel","power bi","tableau","reporting",
+        "machine learning","deep learning","nlp","pandas","statistics",
+        "git","docker","spring boot","rest apis","system design","agile",
+        "computer vision","tensorflow","keras","pytorch","mlops","cloud",
+        "scrum","stakeholder management","product roadmap","user stories"
+    };
+    static_assert(sizeof(kKeys) / sizeof(kKeys[0]) == kVocabSize,
+        "kVocabSize must match the skill vocabulary");
+
+    const char* const* vocabulary() { return kKeys; }
+
+    int indexOf(const std::string& phrase) {
+        static const std::unordered_map<std::string, int> lookup = []() {
+            std::unordered_map<std::string, int> m;
+            for (size_t i = 0; i < kVocabSize; ++i) m.emplace(kKeys[i], (int)i);
+            return m;
+        }();
+        auto it = lookup.find(phrase);
+        return it == lookup.end() ? -1 : it->second;
+    }
+
+    // ---- bitset ----
+    static inline unsigned popcount64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned)__builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (unsigned)((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    bool SkillBits::empty() const {
+        for (size_t k = 0; k < kWords; ++k) if (w[k]) return false;
+        return true;
+    }
+
+    SkillBits fromList(const std::string& joined) {
+        SkillBits b;
+        size_t start = 0;
+        while (start <= joined.size()) {
+            size_t bar = joined.find('|', start);
+            if (bar == std::string::npos) bar = joined.size();
+            const int i = indexOf(joined.substr(start, bar - start));
+            if (i >= 0) b.set((size_t)i);
+            start = bar + 1;
+        }
+        return b;
+    }
+
+    SkillBits extract(const char* text, size_t n) {
+        static const AhoCorasick matcher(
+            std::vector<std::string>(kKeys, kKeys + kVocabSize), true);
+        SkillBits b;
+        matcher.scan(text, n, [&b](std::uint32_t k) { b.set(k); });
+        return b;
+    }
+
+    std::string toList(const SkillBits& b) {
+        std::string out;
+        for (size_t i = 0; i < kVocabSize; ++i) {
+            if (!b.test(i)) continue;
+            if (!out.empty()) out.push_back('|');
+            out += kKeys[i];
+        }
+        return out;
+    }
+
+    double jaccard(const SkillBits& a, const SkillBits& b) {
+        unsigned inter = 0, uni = 0;
+        for (size_t k = 0; k < kWords; ++k) {
+            inter += popcount64(a.w[k] & b.w[k]);
+            uni += popcount64(a.w[k] | b.w[k]);
+        }
+        return uni ? (double)inter / (double)uni : 0.0;
+    }
+
+    // ---- matrix ----
+    void SkillMatrix::push_back(const SkillBits& b) {
+        for (size_t k = 0; k < kWords; ++k) planes[k].push_back(b.w[k]);
+        ++rows;
+    }
+
+    void SkillMatrix::clear() {
+        for (size_t k = 0; k < kWords; ++k) planes[k].clear();
+        rows = 0;
+    }
+
+#if defined(__AVX2__)
+    // per-lane popcount of 4 x u64 (nibble lookup + horizontal byte sum)
+    static inline __m256i popcount64x4(__m256i v) {
+        const __m256i lut = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        const __m256i lo = _mm256_and_si256(v, low);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+        const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo),
+            _mm256_shuffle_epi8(lut, hi));
+        return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+    }
+
+    // low 32 bits of each u64 lane -> 4 doubles
+    static inline __m256d lanesToDouble(__m256i v) {
+        const __m256i pick = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        return _mm256_cvtepi32_pd(
+            _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, pick)));
+    }
+#endif
+
+    void jaccardAll(const SkillBits& q, const SkillMatrix& m, double* out) {
+        jaccardRange(q, m, 0, m.size(), out);
+    }
+
+    void jaccardRange(const SkillBits& q, const SkillMatrix& m,
+        size_t begin, size_t end, double* out) {
+        size_t i = begin;
+#if defined(__AVX2__)
+        const __m256d one = _mm256_set1_pd(1.0);
+        for (; i + 4 <= end; i += 4) {
+            __m256i inter = _mm256_setzero_si256();
+            __m256i uni = _mm256_setzero_si256();
+            for (size_t k = 0; k < kWords; ++k) {
+                const __m256i qk = _mm256_set1_epi64x((long long)q.w[k]);
+                const __m256i r = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(m.plane(k) + i));
+                inter = _mm256_add_epi64(inter, popcount64x4(_mm256_and_si256(qk, r)));
+                uni = _mm256_add_epi64(uni, popcount64x4(_mm256_or_si256(qk, r)));
+            }
+            // empty union has an empty intersection, so max(uni, 1) yields 0
+            const __m256d s = _mm256_div_pd(lanesToDouble(inter),
+                _mm256_max_pd(lanesToDouble(uni), one));
+            _mm256_storeu_pd(out + (i - begin), s);
+        }
+#endif
+        for (; i < end; ++i) {
+            unsigned inter = 0, uni = 0;
+            for (size_t k = 0; k < kWords; ++k) {
+                const std::uint64_t r = m.plane(k)[i];
+                inter += popcount64(q.w[k] & r);
+                uni += popcount64(q.w[k] | r);
+            }
+            out[i - begin] = uni ? (double)inter / (double)uni : 0.0;
+        }
+    }
+
+} // namespace skills
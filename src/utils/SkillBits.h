@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fixed skill vocabulary as bitsets. Bit i <-> skills::vocabulary()[i];
+// the word count follows the vocabulary, so growing past 64 skills only
+// widens SkillBits and the matrix planes.
+namespace skills {
+
+    constexpr size_t kVocabSize = 28;
+    constexpr size_t kWords = (kVocabSize + 63) / 64;
+
+    const char* const* vocabulary();   // kVocabSize lower-case phrases
+    int indexOf(const std::string& phrase);   // -1 when not in the vocabulary
+
+    struct SkillBits {
+        std::uint64_t w[kWords] = {};
+
+        void set(size_t i) { w[i / 64] |= (std::uint64_t)1 << (i % 64); }
+        bool test(size_t i) const { return (w[i / 64] >> (i % 64)) & 1u; }
+        bool empty() const;
+    };
+
+    // Parses an extracted skill list ("sql|power bi"); unknown phrases are ignored.
+    SkillBits fromList(const std::string& joined);
+
+    // Every vocabulary phrase occurring anywhere in the text, case-insensitive,
+    // found in one Aho-Corasick pass (cost does not grow with the vocabulary).
+    SkillBits extract(const char* text, size_t n);
+
+    // Set phrases joined with '|' in vocabulary order ("" when empty).
+    std::string toList(const SkillBits& b);
+
+    double jaccard(const SkillBits& a, const SkillBits& b);
+
+    // Column store of SkillBits, one contiguous plane per 64-bit word, so the
+    // scoring kernel streams rows without strided loads.
+    class SkillMatrix {
+    public:
+        void push_back(const SkillBits& b);
+        void clear();
+        size_t size() const { return rows; }
+        const std::uint64_t* plane(size_t word) const { return planes[word].data(); }
+
+    private:
+        std::vector<std::uint64_t> planes[kWords];
+        size_t rows = 0;
+    };
+
+    // out[i] = jaccard(q, row i) for every row: popcount(AND) / popcount(OR),
+    // four rows per step under AVX2, scalar popcount otherwise.
+    void jaccardAll(const SkillBits& q, const SkillMatrix& m, double* out);
+
+    // Same for rows [begin, end) only: out[i - begin] = jaccard(q, row i).
+    void jaccardRange(const SkillBits& q, const SkillMatrix& m,
+        size_t begin, size_t end, double* out);
+
+} // namespace skills
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Append-only object pool for list nodes. Objects are constructed back to
+// back in fixed-size slabs, so nodes created in sequence share cache lines
+// and pages, and clear() releases whole slabs instead of one node at a time.
+// There is no per-object free: a container drops its nodes all at once.
+template<typename T, std::size_t SlabSize = 1024>
+class SlabPool {
+public:
+    SlabPool() = default;
+    ~SlabPool() { clear(); }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    SlabPool(SlabPool&& other) noexcept { swap(other); }
+    SlabPool& operator=(SlabPool&& other) noexcept {
+        if (this != &other) { clear(); swap(other); }
+        return *this;
+    }
+
+    // Brace-initialises T in the next free slot.
+    template<typename... Args>
+    T* create(Args&&... args) {
+        if (used == SlabSize) {
+            slabs.emplace_back(new Slot[SlabSize]);
+            used = 0;
+        }
+        T* p = reinterpret_cast<T*>(&slabs.back()[used]);
+        new (p) T{ std::forward<Args>(args)... };
+        ++used;
+        return p;
+    }
+
+    // Destroys every object, in creation order, and frees the slabs.
+    void clear() {
+        for (std::size_t s = 0; s < slabs.size(); ++s) {
+            const std::size_t n = (s + 1 == slabs.size()) ? used : SlabSize;
+            for (std::size_t i = 0; i < n; ++i)
+                reinterpret_cast<T*>(&slabs[s][i])->~T();
+        }
+        slabs.clear();
+        used = SlabSize;
+    }
+
+    std::size_t size() const {
+        return slabs.empty() ? 0 : (slabs.size() - 1) * SlabSize + used;
+    }
+
+    void swap(SlabPool& other) noexcept {
+        slabs.swap(other.slabs);
+        std::swap(used, other.used);
+    }
+
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::size_t used = SlabSize;   // constructed slots in the last slab
+};
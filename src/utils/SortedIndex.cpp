@@ -0,0 +1,14 @@
+#include "utils/SortedIndex.h"
+
+void SortedIndex::order(std::vector<Row>& rows) const {
+    // Many hits: one walk of the run with a membership mark beats sorting.
+    if (rows.size() * 16 >= run.size()) {
+        std::vector<std::uint8_t> hit(run.size(), 0);
+        for (Row r : rows) hit[r] = 1;
+        rows.clear();
+        for (Row r : run)
+            if (hit[r]) rows.push_back(r);
+        return;
+    }
+    std::sort(rows.begin(), rows.end(), [this](Row a, Row b) { return ranks[a] < ranks[b]; });
+}
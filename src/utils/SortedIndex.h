@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "io/CsvScanner.h"
+#include "utils/KeySort.h"
+
+// Rows kept in key order as a sorted run plus a delta of rows added since
+// the last settle(). add() is O(1); settle() key-sorts the delta and merges
+// it into the run (O(n) merge, no re-sort of the run) and refreshes the
+// row -> rank column. Once settled, putting any set of rows into key order
+// is an integer sort or a walk of the run, with no string compares.
+//
+// Keys compare as bytes (std::string operator<). Ties keep row order, so the
+// order matches a stable sort of the rows by key.
+class SortedIndex {
+public:
+    using Row = std::uint32_t;
+
+    void clear() { run.clear(); delta.clear(); ranks.clear(); }
+
+    // Rows must be added in ascending order (0, 1, 2, ...).
+    void add(Row row) { delta.push_back(row); }
+
+    size_t size() const { return run.size() + delta.size(); }
+    bool   settled() const { return delta.empty(); }
+
+    // keyAt(row) -> TextView of the row's key.
+    template<typename KeyAt>
+    void settle(KeyAt keyAt, unsigned threads = 0);
+
+    // All rows in key order; needs settled().
+    const std::vector<Row>& ordered() const { return run; }
+    Row rankOf(Row row) const { return ranks[row]; }
+
+    // Reorders `rows` (distinct, any order) into key order; needs settled().
+    void order(std::vector<Row>& rows) const;
+
+private:
+    static bool less(const TextView& a, const TextView& b) {
+        const size_t n = a.size < b.size ? a.size : b.size;
+        const int c = n ? std::memcmp(a.data, b.data, n) : 0;
+        return c < 0 || (c == 0 && a.size < b.size);
+    }
+
+    std::vector<Row> run;     // settled rows, key order
+    std::vector<Row> delta;   // rows added since, ascending
+    std::vector<Row> ranks;   // row -> position in run
+};
+
+template<typename KeyAt>
+void SortedIndex::settle(KeyAt keyAt, unsigned threads) {
+    if (delta.empty()) return;
+
+    std::vector<TextView> keys(delta.size());
+    for (size_t i = 0; i < delta.size(); ++i) keys[i] = keyAt(delta[i]);
+    std::vector<std::uint32_t> perm;
+    keysort::order(keys, false, threads, perm);
+    std::vector<Row> added(delta.size());
+    for (size_t i = 0; i < perm.size(); ++i) added[i] = delta[perm[i]];
+
+    // delta rows are newer than every run row, so on equal keys the run goes first
+    std::vector<Row> merged;
+    merged.reserve(run.size() + added.size());
+    std::merge(run.begin(), run.end(), added.begin(), added.end(), std::back_inserter(merged),
+        [&](Row a, Row b) { return less(keyAt(a), keyAt(b)); });
+    run.swap(merged);
+    delta.clear();
+
+    ranks.resize(run.size());
+    for (size_t i = 0; i < run.size(); ++i) ranks[run[i]] = static_cast<Row>(i);
+}
@@ -0,0 +1,86 @@
+#include "utils/ThreadPool.h"
+
+unsigned ThreadPool::defaultThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = defaultThreads();
+    for (unsigned i = 0; i < threads; ++i)
+        queues.emplace_back(new Queue());
+    for (unsigned i = 0; i < threads; ++i)
+        workers.emplace_back([this, i]() { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void ThreadPool::submit(Task task) {
+    const unsigned q = nextQueue.fetch_add(1) % size();
+    pending.fetch_add(1);
+    {
+        // count first, under the sleep lock, so a worker can neither miss the
+        // wake-up nor take the task before it is counted
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        queued.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lk(queues[q]->m);
+        queues[q]->tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lk(sleepMutex);
+    idle.wait(lk, [this]() { return pending.load() == 0; });
+}
+
+bool ThreadPool::popOrSteal(unsigned self, Task& out) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lk(own.m);
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // queues, not workers: that vector is still growing while the first workers start
+    const unsigned n = static_cast<unsigned>(queues.size());
+    for (unsigned k = 1; k < n; ++k) {
+        Queue& victim = *queues[(self + k) % n];
+        std::lock_guard<std::mutex> lk(victim.m);
+        if (!victim.tasks.empty()) {
+            out = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned self) {
+    for (;;) {
+        Task task;
+        if (popOrSteal(self, task)) {
+            queued.fetch_sub(1);
+            task();
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lk(sleepMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lk(sleepMutex);
+        wake.wait(lk, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size work-stealing pool. Each worker owns a deque: it pops its own
+// work from the front and, when empty, steals from the back of the others.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threads = 0);   // 0 = hardware_concurrency
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Queues a task on the next worker (round-robin).
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished. Not callable from a task.
+    void wait();
+
+    // Runs fn(begin, end) over [0, n) in chunks of `grain` and waits.
+    template<typename Fn>
+    void parallelFor(size_t n, size_t grain, Fn fn) {
+        if (n == 0) return;
+        if (grain == 0) grain = 1;
+        for (size_t b = 0; b < n; b += grain) {
+            const size_t e = (b + grain < n) ? b + grain : n;
+            submit([fn, b, e]() { fn(b, e); });
+        }
+        wait();
+    }
+
+    static unsigned defaultThreads();
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned self);
+    bool popOrSteal(unsigned self, Task& out);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<size_t> queued{ 0 };    // submitted, not yet picked up
+    std::atomic<size_t> pending{ 0 };   // submitted, not yet finished
+    std::atomic<unsigned> nextQueue{ 0 };
+    bool stopping = false;
+};
@@ -0,0 +1,138 @@
+#include "utils/TokenDictionary.h"
+#include <algorithm>
+#include <cctype>
+
+// ---- helpers ----
+static char toLowerChar(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+static bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// ---- dictionary ----
+TokenDictionary& TokenDictionary::global() {
+    static TokenDictionary dict;
+    return dict;
+}
+
+TokenId TokenDictionary::internLocked(const std::string& token) {
+    auto it = ids.find(token);
+    if (it != ids.end()) return it->second;
+    const TokenId id = static_cast<TokenId>(texts.size());
+    ids.emplace(token, id);
+    texts.push_back(token);
+    return id;
+}
+
+TokenId TokenDictionary::intern(const std::string& token) {
+    std::lock_guard<std::mutex> lk(m);
+    return internLocked(token);
+}
+
+void TokenDictionary::internAll(const std::vector<std::string>& batch, TokenIds& out) {
+    out.clear();
+    out.reserve(batch.size());
+    {
+        std::lock_guard<std::mutex> lk(m);
+        for (const auto& t : batch) out.push_back(internLocked(t));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void TokenDictionary::lookupAll(const std::vector<std::string>& batch, TokenIds& out) const {
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lk(m);
+        for (const auto& t : batch) {
+            auto it = ids.find(t);
+            if (it != ids.end()) out.push_back(it->second);
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+bool TokenDictionary::lookup(const std::string& token, TokenId& id) const {
+    std::lock_guard<std::mutex> lk(m);
+    auto it = ids.find(token);
+    if (it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+std::string TokenDictionary::text(TokenId id) const {
+    std::lock_guard<std::mutex> lk(m);
+    return id < texts.size() ? texts[id] : std::string();
+}
+
+size_t TokenDictionary::size() const {
+    std::lock_guard<std::mutex> lk(m);
+    return texts.size();
+}
+
+// ---- tokenizers ----
+// split on | , ; / then trimmed and lower-cased
+void tokens::skillPhrases(const std::string& raw, std::vector<std::string>& parts) {
+    std::string cur;
+    auto flush = [&]() {
+        size_t b = 0, e = cur.size();
+        while (b < e && isSpace(cur[b])) ++b;
+        while (e > b && isSpace(cur[e - 1])) --e;
+        if (e > b) parts.push_back(cur.substr(b, e - b));
+        cur.clear();
+    };
+    for (char c : raw) {
+        if (c == '|' || c == ',' || c == ';' || c == '/') flush();
+        else cur.push_back(toLowerChar(c));
+    }
+    flush();
+}
+
+void tokens::skillIds(const std::string& raw, TokenIds& out) {
+    std::vector<std::string> parts;
+    tokens::skillPhrases(raw, parts);
+    TokenDictionary::global().internAll(parts, out);
+}
+
+void tokens::knownSkillIds(const std::string& raw, TokenIds& out) {
+    std::vector<std::string> parts;
+    tokens::skillPhrases(raw, parts);
+    TokenDictionary::global().lookupAll(parts, out);
+}
+
+void tokens::wordIds(const std::string& text, TokenIds& out) {
+    std::vector<std::string> words;
+    std::string cur;
+    for (char c : text) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            cur.push_back(toLowerChar(c));
+        }
+        else {
+            if (cur.size() >= 2) words.push_back(cur);
+            cur.clear();
+        }
+    }
+    if (cur.size() >= 2) words.push_back(cur);
+    TokenDictionary::global().internAll(words, out);
+}
+
+// ---- set kernels ----
+size_t tokens::intersectCount(const TokenIds& a, const TokenIds& b) {
+    size_t i = 0, j = 0, inter = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] == b[j]) { ++inter; ++i; ++j; }
+        else if (a[i] < b[j]) ++i;
+        else ++j;
+    }
+    return inter;
+}
+
+double tokens::jaccard(const TokenIds& a, const TokenIds& b) {
+    const size_t inter = intersectCount(a, b);
+    const size_t uni = a.size() + b.size() - inter;
+    if (uni == 0) return 0.0;
+    return static_cast<double>(inter) / static_cast<double>(uni);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using TokenId = std::uint32_t;
+using TokenIds = std::vector<TokenId>;   // always sorted, no duplicates
+
+// Interns every distinct token once and hands out dense integer ids, so
+// similarity code compares integers instead of strings.
+class TokenDictionary {
+public:
+    static TokenDictionary& global();
+
+    TokenId intern(const std::string& token);
+    // Interns a batch under one lock and returns the ids sorted and unique.
+    void internAll(const std::vector<std::string>& batch, TokenIds& out);
+    // Ids of the tokens already interned (the rest are dropped), sorted and
+    // unique; never grows the dictionary.
+    void lookupAll(const std::vector<std::string>& batch, TokenIds& out) const;
+    bool lookup(const std::string& token, TokenId& id) const;
+    std::string text(TokenId id) const;
+    size_t size() const;
+
+private:
+    TokenId internLocked(const std::string& token);
+
+    mutable std::mutex m;
+    std::unordered_map<std::string, TokenId> ids;
+    std::vector<std::string> texts;
+};
+
+namespace tokens {
+    // Skill phrases split on | , ; / then trimmed and lower-cased
+    // ("SQL|Power BI" -> {"sql", "power bi"}). Used by the linked-list matcher.
+    void skillIds(const std::string& raw, TokenIds& out);
+    // The phrases skillIds() would intern, in text order (appended to `out`).
+    void skillPhrases(const std::string& raw, std::vector<std::string>& out);
+    // skillIds limited to phrases something has already interned, for text
+    // that is scored but not kept (streamed resumes).
+    void knownSkillIds(const std::string& raw, TokenIds& out);
+
+    // Lower-cased alnum words of length >= 2. Used by the array matcher.
+    void wordIds(const std::string& text, TokenIds& out);
+
+    // Size of the intersection of two sorted id vectors (linear merge).
+    size_t intersectCount(const TokenIds& a, const TokenIds& b);
+
+    // Intersection over union, 0 when both are empty.
+    double jaccard(const TokenIds& a, const TokenIds& b);
+}
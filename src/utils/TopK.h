@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Bounded top-K selector: keeps the K best (score, id) pairs offered so far
+// in a bounded min-heap, so ranking N items costs O(N log K) time and
+// O(min(N, K)) memory instead of sorting all N scores. The heap grows with
+// the entries actually kept: a huge K costs nothing until items arrive.
+//
+// "Better" means a higher score, then a smaller id. Ties are therefore broken
+// the same way whatever order the items arrive in.
+template<typename Score, typename Id = std::size_t>
+class TopK {
+public:
+    struct Entry {
+        Score score;
+        Id    id;
+    };
+
+    explicit TopK(std::size_t k = 0) { reset(k); }
+
+    // Empties the selector and sets a new capacity.
+    void reset(std::size_t k) {
+        cap = k;
+        heap.clear();
+        heap.reserve(initialSlots());
+    }
+
+    std::size_t capacity() const { return cap; }
+    std::size_t size() const { return heap.size(); }
+    bool        empty() const { return heap.empty(); }
+    bool        full() const { return heap.size() >= cap; }
+
+    // Weakest kept entry (the one the next better offer evicts); needs !empty().
+    const Entry& weakest() const { return heap.front(); }
+
+    static bool better(const Entry& a, const Entry& b) {
+        return a.score > b.score || (a.score == b.score && a.id < b.id);
+    }
+
+    // Would (score, id) be kept right now?
+    bool accepts(Score score, Id id) const {
+        return cap > 0 && (heap.size() < cap || better(Entry{ score, id }, heap.front()));
+    }
+
+    // Returns true when the pair was kept.
+    bool offer(Score score, Id id) {
+        if (!accepts(score, id)) return false;
+        const Entry e{ score, id };
+        if (heap.size() < cap) {
+            heap.push_back(e);
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+        else {
+            // front is the weakest kept entry
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = e;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+        return true;
+    }
+
+    // Moves the kept entries into `out`, best first, and empties the selector.
+    void take(std::vector<Entry>& out) {
+        std::sort_heap(heap.begin(), heap.end(), better);
+        out.swap(heap);
+        heap.clear();
+        heap.reserve(initialSlots());
+    }
+
+private:
+    // Up-front slots: enough for the usual small K, never K itself, which
+    // may be far beyond what will ever be offered.
+    std::size_t initialSlots() const { return cap < kReserveMax ? cap : kReserveMax; }
+
+    enum : std::size_t { kReserveMax = 64 };
+
+    std::vector<Entry> heap;
+    std::size_t cap = 0;
+};
@@ -0,0 +1,129 @@
+#include "utils/WeightedIndex.h"
+#include <algorithm>
+#include <cmath>
+
+// ---- sparse rows ----
+void WeightedIndex::Rows::append(const std::vector<Term>& ids, const std::vector<float>& idfs) {
+    double norm = 0;
+    for (Term t : ids) norm += (double)idfs[t] * idfs[t];
+    const float inv = norm > 0 ? (float)(1.0 / std::sqrt(norm)) : 0.0f;
+    for (Term t : ids) {
+        terms.push_back(t);
+        weights.push_back(idfs[t] * inv);
+    }
+    offsets.push_back(terms.size());
+}
+
+void WeightedIndex::Rows::clear() {
+    offsets.assign(1, 0);
+    terms.clear();
+    weights.clear();
+}
+
+// ---- build ----
+void WeightedIndex::clear() {
+    termOf.clear();
+    idfs.clear();
+    jobs.clear();
+    resumes.clear();
+    postStart.clear();
+    postRows.clear();
+    postWeights.clear();
+}
+
+void WeightedIndex::termsOf(const TokenIds& ids, std::vector<Term>& out) const {
+    out.clear();
+    for (TokenId id : ids) {
+        auto it = termOf.find(id);
+        if (it != termOf.end()) out.push_back(it->second);
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void WeightedIndex::build(const ResumeLinkedList& resumeList, const JobLinkedList& jobList) {
+    clear();
+    const size_t n = jobList.rowCount();
+
+    // document frequency over the jobs; terms numbered by first use
+    std::vector<Row> df;
+    for (size_t row = 0; row < n; ++row) {
+        for (TokenId id : jobList.jobAtRow(row).skillIds) {
+            auto ins = termOf.emplace(id, (Term)df.size());
+            if (ins.second) df.push_back(0);
+            ++df[ins.first->second];
+        }
+    }
+    idfs.resize(df.size());
+    for (size_t t = 0; t < df.size(); ++t)
+        idfs[t] = (float)std::log(1.0 + ((double)n - df[t] + 0.5) / (df[t] + 0.5));
+
+    // job vectors, then their weights by term (rows ascending)
+    std::vector<Term> ids;
+    jobs.offsets.reserve(n + 1);
+    for (size_t row = 0; row < n; ++row) {
+        termsOf(jobList.jobAtRow(row).skillIds, ids);
+        jobs.append(ids, idfs);
+    }
+
+    postStart.assign(df.size() + 1, 0);
+    for (size_t t = 0; t < df.size(); ++t) postStart[t + 1] = postStart[t] + df[t];
+    postRows.resize(jobs.terms.size());
+    postWeights.resize(jobs.terms.size());
+    std::vector<size_t> fill(postStart.begin(), postStart.end() - 1);
+    for (size_t row = 0; row < n; ++row) {
+        const Vector v = jobs.at(row);
+        for (size_t i = 0; i < v.size; ++i) {
+            const size_t at = fill[v.terms[i]]++;
+            postRows[at] = (Row)row;
+            postWeights[at] = v.weights[i];
+        }
+    }
+
+    resumes.offsets.reserve(resumeList.rowCount() + 1);
+    for (size_t row = 0; row < resumeList.rowCount(); ++row) {
+        termsOf(resumeList.resumeAtRow(row).skillIds, ids);
+        resumes.append(ids, idfs);
+    }
+}
+
+// ---- queries ----
+float WeightedIndex::idf(TokenId id) const {
+    auto it = termOf.find(id);
+    return it == termOf.end() ? 0.0f : idfs[it->second];
+}
+
+WeightedIndex::Vector WeightedIndex::vectorize(const TokenIds& ids, std::vector<Term>& terms,
+    std::vector<float>& weights) const {
+    termsOf(ids, terms);
+    Rows one;
+    one.append(terms, idfs);
+    weights.swap(one.weights);
+    return Vector{ terms.data(), weights.data(), terms.size() };
+}
+
+size_t WeightedIndex::topJobs(const Vector& q, size_t k, Accumulator& acc, std::vector<Hit>& out) const {
+    out.clear();
+    if (k == 0 || q.size == 0) return 0;
+    if (acc.score.size() < jobs.size()) acc.score.resize(jobs.size(), 0.0f);
+
+    // every weight is positive, so a zero slot means "not touched yet"
+    for (size_t i = 0; i < q.size; ++i) {
+        const Term t = q.terms[i];
+        const float w = q.weights[i];
+        for (size_t p = postStart[t]; p < postStart[t + 1]; ++p) {
+            const Row row = postRows[p];
+            if (acc.score[row] == 0.0f) acc.touched.push_back(row);
+            acc.score[row] += w * postWeights[p];
+        }
+    }
+
+    TopK<float, Row> best(k);
+    for (Row row : acc.touched) {
+        best.offer(acc.score[row], row);
+        acc.score[row] = 0.0f;
+    }
+    const size_t touched = acc.touched.size();
+    acc.touched.clear();
+    best.take(out);
+    return touched;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "models/JobLinkedList.h"
+#include "models/ResumeLinkedList.h"
+#include "utils/TokenDictionary.h"
+#include "utils/TopK.h"
+
+// TF-IDF cosine scoring over skill phrase ids.
+//
+// build() computes each phrase's IDF over the jobs once, stores every job
+// and every resume as an L2-normalized sparse vector, and files the job
+// weights under posting lists (phrase -> job rows). A resume's cosine with
+// all jobs is then accumulated list by list: only jobs sharing a phrase with
+// it are touched, and the rest are never visited.
+//
+// Skill phrases are sets, so tf is 1 and a weight is the IDF alone
+// (idf = ln(1 + (N - df + 0.5) / (df + 0.5)), the BM25 form, N = jobs).
+// Rare phrases therefore outweigh common ones, and resume phrases no job
+// asks for (the filler words among the generated skills) get no weight at
+// all instead of diluting the score as they do in Jaccard.
+class WeightedIndex {
+public:
+    using Row = std::uint32_t;
+    using Term = std::uint32_t;   // dense index of a phrase some job lists
+
+    struct Vector {
+        const Term*  terms;     // ascending
+        const float* weights;   // unit L2 norm (all zero-length when empty)
+        size_t       size;
+    };
+
+    // Per-thread scratch for topJobs(): one score slot per job, all zero
+    // between calls.
+    struct Accumulator {
+        std::vector<float> score;
+        std::vector<Row>   touched;
+    };
+
+    using Hit = TopK<float, Row>::Entry;
+
+    // Recomputes IDF, vectors and posting lists from both lists (rows =
+    // insertion order). Call again after the lists change.
+    void build(const ResumeLinkedList& resumes, const JobLinkedList& jobs);
+    void clear();
+
+    size_t jobCount() const { return jobs.size(); }
+    size_t resumeCount() const { return resumes.size(); }
+    size_t termCount() const { return idfs.size(); }
+
+    // IDF of a phrase, 0 when no job lists it.
+    float idf(TokenId id) const;
+
+    Vector jobVector(size_t row) const { return jobs.at(row); }
+    Vector resumeVector(size_t row) const { return resumes.at(row); }
+
+    // Normalized vector of any phrase set (a resume not in the index);
+    // phrases no job lists are dropped. Points into `terms` and `weights`.
+    Vector vectorize(const TokenIds& ids, std::vector<Term>& terms, std::vector<float>& weights) const;
+
+    // Best k job rows by cosine with `q`, best first; ties go to the smaller
+    // row. Jobs with no phrase in common are not offered. Returns how many
+    // jobs were touched.
+    size_t topJobs(const Vector& q, size_t k, Accumulator& acc, std::vector<Hit>& out) const;
+
+private:
+    // Sparse rows in one block: row i is [offsets[i], offsets[i + 1]).
+    struct Rows {
+        std::vector<size_t> offsets{ 0 };
+        std::vector<Term>   terms;
+        std::vector<float>  weights;
+
+        size_t size() const { return offsets.size() - 1; }
+        Vector at(size_t i) const {
+            const size_t b = offsets[i];
+            return Vector{ terms.data() + b, weights.data() + b, offsets[i + 1] - b };
+        }
+        // Appends `ids` (sorted terms) weighted by idf and normalized.
+        void append(const std::vector<Term>& ids, const std::vector<float>& idfs);
+        void clear();
+    };
+
+    // Terms of the known phrases in `ids`, ascending.
+    void termsOf(const TokenIds& ids, std::vector<Term>& out) const;
+
+    std::unordered_map<TokenId, Term> termOf;
+    std::vector<float> idfs;              // by term
+    Rows jobs;
+    Rows resumes;
+    std::vector<size_t> postStart;        // term -> [postStart[t], postStart[t + 1])
+    std::vector<Row>    postRows;         // ascending within a term
+    std::vector<float>  postWeights;
+};